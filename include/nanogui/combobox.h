@@ -15,6 +15,7 @@
 #pragma once
 
 #include <nanogui/popupbutton.h>
+#include <nanogui/textindex.h>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -22,6 +23,10 @@ NAMESPACE_BEGIN(nanogui)
  * \class ComboBox combobox.h nanogui/combobox.h
  *
  * \brief Simple combo box widget based on a popup button.
+ *
+ * The popup shows the items in a \ref VirtualList, so only the visible
+ * rows are drawn no matter how many items there are. Long lists get a
+ * search field that filters the items as the user types.
  */
 DECLSETTERILIST(ComboBoxItems, std::vector<std::string>)
 DECLSETTERILIST(ComboBoxShortItems, std::vector<std::string>)
@@ -75,6 +80,16 @@ public:
     /// The short descriptions associated with this ComboBox.
     const ShortItems &itemsShort() const { return mItemsShort; }
 
+    /// Only list the items containing ``text`` (case insensitive), an empty string shows all
+    void setFilter(const std::string &text);
+
+    /// Number of items from which the popup shows a search field
+    int searchThreshold() const { return mSearchThreshold; }
+    void setSearchThreshold(int threshold);
+
+    /// The list shown in the popup
+    VirtualList *list() { return mList; }
+
     /// Handles mouse scrolling events for this ComboBox.
     virtual bool scrollEvent(const Vector2i &p, const Vector2f &rel) override;
 
@@ -97,6 +112,21 @@ protected:
     /// The current index this ComboBox has selected.
     int mSelectedIndex;
 
+    /// List of items inside the popup.
+    VirtualList *mList = nullptr;
+
+    /// Search field above the list.
+    TextBox *mSearch = nullptr;
+
+    /// Trigram index of the items, built on the first search.
+    TextIndex mIndex;
+    bool mIndexDirty = true;
+    int mSearchThreshold = 20;
+
+private:
+    void initPopup();
+    void selectItem(int index);
+
 public:
     PROPSETTER(ComboBoxItems, setItems)
 };
@@ -687,6 +687,7 @@ class MessageDialog;
 class Object;
 class Popup;
 class PopupButton;
+class PickBuffer;
 class ProgressBar;
 class Screen;
 class Serializer;
@@ -698,6 +699,7 @@ class TextBox;
 class GLCanvas;
 class Theme;
 class ToolButton;
+class VirtualList;
 class VScrollPanel;
 class Widget;
 class Window;
@@ -724,10 +726,12 @@ NANOGUI_EXPORT void shutdown();
  * \brief Enter the application main loop
  *
  * \param refresh
- *     NanoGUI issues a redraw call whenever an keyboard/mouse/.. event is
- *     received. In the absence of any external events, it enforces a redraw
- *     once every ``refresh`` milliseconds. To disable the refresh timer,
- *     specify a negative value here.
+ *     NanoGUI redraws a screen whenever it receives a keyboard/mouse/..
+ *     event or one of its widgets has requested an animation frame (see
+ *     \ref Screen::requestAnimationFrame). In the absence of any external
+ *     events, it additionally enforces a redraw of all screens once every
+ *     ``refresh`` milliseconds. To disable the refresh timer and only redraw
+ *     on demand, specify a negative value here.
  *
  * \param detach
  *     This parameter only exists in the Python bindings. When the active
@@ -758,6 +762,34 @@ NANOGUI_EXPORT void shutdown();
  */
 NANOGUI_EXPORT void mainloop(int refresh = 50);
 
+/**
+ * \brief Lay out screens in parallel within the main loop.
+ *
+ * When enabled and more than one screen has to be redrawn in the same
+ * iteration, the pending layout pass (\ref Screen::performPendingLayout) of
+ * each screen runs on its own worker thread. Drawing and the backend
+ * submission stay serialized on the main thread, because graphics contexts
+ * are bound to a single thread.
+ *
+ * The worker threads are started once and reused every frame until
+ * \ref mainloop returns.
+ *
+ * This is safe as long as the screens do not share mutable state during
+ * layout: every screen owns its widget tree and NanoVG context (and with it
+ * the font atlas used to measure text), a \ref Theme may be shared since
+ * layout only reads it. With this option on, all code reached from layout
+ * must be thread-safe: ``performLayout`` and ``preferredSize`` overrides,
+ * layout managers and anything they call, e.g. factories creating widgets
+ * on demand. Such code must not touch other screens or global state
+ * (including Python overrides, which would need the GIL), and must leave
+ * creating, deleting or focusing widgets to the UI thread (see
+ * \ref Screen::post). Disabled by default.
+ */
+NANOGUI_EXPORT void appSetParallelLayout(bool enabled);
+
+/// Return whether screens are laid out in parallel, see \ref appSetParallelLayout
+NANOGUI_EXPORT bool appParallelLayout();
+
 /// Request the application main loop to terminate (e.g. if you detached mainloop).
 NANOGUI_EXPORT void leave();
 
@@ -794,6 +826,8 @@ NANOGUI_EXPORT bool appPostEmptyEvent();
 NANOGUI_EXPORT void appForEachScreen(std::function<void(Screen*)> f);
 NANOGUI_EXPORT bool appIsShouldCloseScreen(Screen* screen);
 NANOGUI_EXPORT bool appWaitEvents();
+/// Wait for events, but no longer than ``timeout`` seconds
+NANOGUI_EXPORT bool appWaitEventsTimeout(double timeout);
 NANOGUI_EXPORT bool appPollEvents();
 NANOGUI_EXPORT float getTimeFromStart();
 
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <nanogui/popupbutton.h>
+#include <nanogui/textindex.h>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -22,6 +23,9 @@ NAMESPACE_BEGIN(nanogui)
  * \class DropdownBox dropdownbox.h nanogui/dropdownbox.h
  *
  * \brief Simple dropdownbox box widget based on a popup button.
+ *
+ * Like \ref ComboBox, the items are shown in a \ref VirtualList and long
+ * lists can be searched.
  */
 DECLSETTERILIST(DropdownBoxItems, std::vector<std::string>)
 
@@ -76,6 +80,13 @@ public:
     /// The short descriptions associated with this dropdownbox.
     const ShortItems &itemsShort() const { return mItemsShort; }
 
+    /// Only list the items containing ``text`` (case insensitive), an empty string shows all
+    void setFilter(const std::string &text);
+
+    /// Number of items from which the popup shows a search field
+    int searchThreshold() const { return mSearchThreshold; }
+    void setSearchThreshold(int threshold);
+
     /// Handles mouse scrolling events for this dropdownbox.
     virtual bool scrollEvent(const Vector2i &p, const Vector2f &rel) override;
 
@@ -101,6 +112,20 @@ protected:
     /// The current index this dropdownbox has selected.
     int mSelectedIndex;
 
+    /// List of items inside the popup, below the header.
+    VirtualList *mList = nullptr;
+
+    /// Search field between the header and the list.
+    TextBox *mSearch = nullptr;
+
+    /// Trigram index of the items, built on the first search.
+    TextIndex mIndex;
+    bool mIndexDirty = true;
+    int mSearchThreshold = 20;
+
+private:
+    void selectItem(int index);
+
 public:
     PROPSETTER(DropdownBoxItems, setItems)
 };
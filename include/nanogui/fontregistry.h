@@ -0,0 +1,65 @@
+/*
+    nanogui/fontregistry.h -- Per-context font name to handle mapping
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/common.h>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class FontRegistry fontregistry.h nanogui/fontregistry.h
+ *
+ * \brief Resolves font names of a NanoVG context to integer handles.
+ *
+ * ``nvgFontFace`` compares the requested name against every loaded font on
+ * each call. Widgets resolve their font once through the registry and
+ * then select it with ``nvgFontFaceId``. The registry also keeps the
+ * fallback chains that were set up for missing glyphs.
+ *
+ * There is one registry per NanoVG context, like the context itself it
+ * must only be used by one thread at a time.
+ */
+class NANOGUI_EXPORT FontRegistry {
+public:
+    /// Return the registry of ``ctx``, it is created on first use
+    static FontRegistry &get(NVGcontext *ctx);
+
+    /// Drop the registry of ``ctx`` (called before the context is deleted)
+    static void release(NVGcontext *ctx);
+
+    /// Return the handle of the font ``name``, or -1 if it was not loaded
+    int resolve(const std::string &name);
+
+    /**
+     * \brief Use ``fallback`` for glyphs that are missing in ``base``.
+     *
+     * Fallbacks are tried in the order they were added. Throws if one of
+     * the fonts is not loaded.
+     */
+    void addFallback(const std::string &base, const std::string &fallback);
+
+    /// Return the fallback chain of the font with handle ``font``
+    const std::vector<int> &fallbacks(int font) const;
+
+private:
+    explicit FontRegistry(NVGcontext *ctx) : mContext(ctx) {}
+
+    NVGcontext *mContext;
+    std::unordered_map<std::string, int> mHandles;
+    std::map<int, std::vector<int>> mFallbacks;
+};
+
+NAMESPACE_END(nanogui)
@@ -80,6 +80,43 @@ public:
         GLuint compSize;///< The size (in bytes) of an individual element in this buffer.
         GLuint size;    ///< The total number of elements represented by this buffer.
         int version;    ///< The current version if this buffer.
+        GLenum target = GL_ARRAY_BUFFER; ///< ``GL_ARRAY_BUFFER`` or ``GL_ELEMENT_ARRAY_BUFFER`` (indices).
+        GLint attribID = -1;  ///< The cached attribute location (-1 for the index buffer).
+        size_t capacity = 0;  ///< The number of bytes currently allocated on the GPU.
+    };
+
+    /**
+     * \struct UniformHandle glutil.h nanogui/glutil.h
+     *
+     * A uniform location resolved once via \ref GLShader::uniformHandle, so
+     * that per-frame \ref GLShader::setUniform calls skip the name lookup.
+     */
+    struct UniformHandle {
+        GLint id = -1;
+        bool valid() const { return id >= 0; }
+    };
+
+    /**
+     * \struct AttribSlot glutil.h nanogui/glutil.h
+     *
+     * The resolved location of an attribute.  The buffer entry in
+     * \ref mBufferObjects is only created by the first upload.
+     */
+    struct AttribSlot {
+        std::string name;
+        GLint attribID = -1;        ///< The attribute location (-1 for the index buffer).
+        Buffer *buffer = nullptr;   ///< The uploaded buffer, ``nullptr`` until the first upload.
+    };
+
+    /**
+     * \struct AttribHandle glutil.h nanogui/glutil.h
+     *
+     * An attribute slot resolved once via \ref GLShader::attribHandle.  The
+     * handle remains valid until \ref GLShader::free is called.
+     */
+    struct AttribHandle {
+        AttribSlot *slot = nullptr;
+        bool valid() const { return slot != nullptr; }
     };
 
     /// Create an unitialized OpenGL shader
@@ -154,6 +191,22 @@ public:
     /// Return the handle of a uniform attribute (-1 if it does not exist)
     GLint uniform(const std::string &name, bool warn = true) const;
 
+    /// Resolve a uniform once; the handle can be passed to \ref setUniform every frame
+    UniformHandle uniformHandle(const std::string &name, bool warn = true) const {
+        UniformHandle h;
+        h.id = uniform(name, warn);
+        return h;
+    }
+
+    /**
+     * Resolve an attribute (or ``"indices"``) once, so that later uploads
+     * through the handle skip both the map lookup and ``glGetAttribLocation``.
+     * Only the location is cached; \ref hasAttrib stays false until data is
+     * uploaded.  Returns an invalid handle if the attribute does not exist in
+     * the linked program.
+     */
+    AttribHandle attribHandle(const std::string &name, bool warn = true);
+
     /// Upload an Eigen matrix as a vertex buffer object (refreshing it as needed)
     template <typename Matrix> void uploadAttrib(const std::string &name, const Matrix &M, int version = -1) {
         uint32_t compSize = sizeof(typename Matrix::Scalar);
@@ -164,6 +217,16 @@ public:
                      glType, integral, M.data(), version);
     }
 
+    /// Upload an Eigen matrix through a precomputed attribute handle
+    template <typename Matrix> void uploadAttrib(AttribHandle handle, const Matrix &M, int version = -1) {
+        uint32_t compSize = sizeof(typename Matrix::Scalar);
+        GLuint glType = (GLuint) detail::type_traits<typename Matrix::Scalar>::type;
+        bool integral = (bool) detail::type_traits<typename Matrix::Scalar>::integral;
+
+        uploadAttrib(handle, (uint32_t) M.size(), (int) M.rows(), compSize,
+                     glType, integral, M.data(), version);
+    }
+
     /// Download a vertex buffer object into an Eigen matrix
     template <typename Matrix> void downloadAttrib(const std::string &name, Matrix &M) {
         uint32_t compSize = sizeof(typename Matrix::Scalar);
@@ -302,6 +365,23 @@ public:
     /// Initialize a uniform buffer with a uniform buffer object
     void setUniform(const std::string &name, const GLUniformBuffer &buf, bool warn = true);
 
+    /// Initialize a uniform parameter with a boolean value (precomputed handle)
+    void setUniform(UniformHandle handle, bool value) {
+        glUniform1i(handle.id, (int) value);
+    }
+
+    /// Initialize a uniform parameter with an integer value (precomputed handle)
+    template <typename T, typename std::enable_if<detail::type_traits<T>::integral == 1, int>::type = 0>
+    void setUniform(UniformHandle handle, T value) {
+        glUniform1i(handle.id, (int) value);
+    }
+
+    /// Initialize a uniform parameter with a floating point value (precomputed handle)
+    template <typename T, typename std::enable_if<detail::type_traits<T>::integral == 0, int>::type = 0>
+    void setUniform(UniformHandle handle, T value) {
+        glUniform1f(handle.id, (float) value);
+    }
+
     /// Return the size of all registered buffers in bytes
     size_t bufferSize() const {
         size_t size = 0;
@@ -355,6 +435,23 @@ public:
                        const void *data, int version = -1);
     void downloadAttrib(const std::string &name, size_t size, int dim,
                        uint32_t compSize, GLuint glType, void *data);
+    void uploadAttrib(AttribHandle handle, size_t size, int dim,
+                      uint32_t compSize, GLuint glType, bool integral,
+                      const void *data, int version = -1);
+
+    /**
+     * \brief Streaming path for data that is rewritten every frame.
+     *
+     * Orphans the buffer storage and maps it for writing, so the driver never
+     * has to wait for draw calls that still read the previous contents.  The
+     * caller fills ``size * compSize`` bytes and must call \ref unmapAttrib
+     * before drawing.  Returns ``nullptr`` if the handle is invalid or the
+     * mapping failed.
+     */
+    void *mapAttrib(AttribHandle handle, size_t size, int dim,
+                    uint32_t compSize, GLuint glType, bool integral,
+                    int version = -1);
+    void unmapAttrib(AttribHandle handle);
 
 protected:
     /// The registered name of this GLShader.
@@ -381,6 +478,16 @@ protected:
      */
     std::map<std::string, Buffer> mBufferObjects;
 
+    /// Locations resolved by \ref uniform and \ref attrib, valid until the program is relinked.
+    mutable std::map<std::string, GLint> mUniformLocations;
+    mutable std::map<std::string, GLint> mAttribLocations;
+
+    /// Slots referenced by the handles returned from \ref attribHandle.
+    std::map<std::string, AttribSlot> mAttribSlots;
+
+    /// Buffer entry of a slot, created on the first upload.
+    Buffer &slotBuffer(AttribSlot &slot);
+
     /**
      * \rst
      * The map of preprocessor names to values (if any have been created).  If
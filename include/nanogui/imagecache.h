@@ -0,0 +1,124 @@
+/*
+    nanogui/imagecache.h -- Per-context cache of GPU images with reference
+    counted handles and a memory budget
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/common.h>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+NAMESPACE_BEGIN(nanogui)
+
+/// Image owned by an \ref ImageCache
+struct CachedImage {
+    /// NanoVG image, 0 once the owning context was released
+    int image = 0;
+    int width = 0, height = 0;
+    /// Estimated GPU memory in bytes
+    size_t bytes = 0;
+};
+
+/// Keeps a cached image alive, see \ref ImageCache
+using ImageHandle = std::shared_ptr<const CachedImage>;
+
+/**
+ * \class ImageCache imagecache.h nanogui/imagecache.h
+ *
+ * \brief Shares the images of a NanoVG context and bounds their memory.
+ *
+ * Images are looked up by name first and by their encoded data second, so
+ * the same file or resource is only uploaded once even when it is loaded
+ * under different names. The encoded data is kept next to each image to
+ * confirm hash matches byte by byte. Callers hold on to an \ref ImageHandle
+ * for as long as they draw the image. Images nobody holds a handle to stay
+ * cached for reuse until \ref memoryUsage exceeds \ref budget, then the
+ * least recently loaded ones are deleted.
+ *
+ * Icons created by \ref nvgImageIcon are pinned: they are referenced by
+ * plain image ids all over the place and are never evicted.
+ *
+ * There is one cache per NanoVG context. Like the context itself, a cache
+ * must only be used by one thread at a time.
+ */
+class NANOGUI_EXPORT ImageCache {
+public:
+    /// Return the cache of ``ctx``, it is created on first use
+    static ImageCache &get(NVGcontext *ctx);
+
+    /// Delete all images of ``ctx`` (called before the context is deleted)
+    static void release(NVGcontext *ctx);
+
+    ~ImageCache();
+
+    /**
+     * \brief Return the image encoded in ``data`` (PNG, JPEG, ...).
+     *
+     * ``name`` identifies the data, a name that was loaded before returns
+     * the cached image without looking at ``data``. ``imageFlags`` are
+     * NanoVG image flags. Throws if the data cannot be decoded.
+     */
+    ImageHandle load(const std::string &name, const uint8_t *data, size_t size,
+                     int imageFlags = 0);
+
+    /// Load an image file, see \ref load
+    ImageHandle loadFile(const std::string &path, int imageFlags = 0);
+
+    /// Pinned variant of \ref load returning the plain image id (used by \ref nvgImageIcon)
+    int icon(const std::string &name, const uint8_t *data, size_t size);
+
+    /// GPU memory the unpinned images may use before unused ones are evicted
+    size_t budget() const { return mBudget; }
+    void setBudget(size_t bytes) { mBudget = bytes; trim(); }
+
+    /// Estimated GPU memory of all cached images
+    size_t memoryUsage() const { return mMemoryUsage; }
+
+    /// Number of cached images
+    size_t size() const { return mEntries.size(); }
+
+    /// Evict unused images until the cache fits its budget
+    void trim();
+
+    /// Evict all images nobody holds a handle to
+    void purgeUnused();
+
+private:
+    explicit ImageCache(NVGcontext *ctx) : mContext(ctx) {}
+
+    struct Entry {
+        std::shared_ptr<CachedImage> image;
+        uint64_t hash;
+        std::vector<uint8_t> data; /* encoded, to confirm hash matches */
+        std::vector<std::string> names;
+        bool pinned = false;
+    };
+    using Iterator = std::list<Entry>::iterator;
+
+    Iterator find(const std::string &name, const uint8_t *data, size_t size,
+                  int imageFlags);
+    void evict(Iterator it);
+    bool evictable(const Entry &entry) const {
+        return !entry.pinned && entry.image.use_count() == 1;
+    }
+
+    NVGcontext *mContext;
+    size_t mBudget = 256 * 1024 * 1024;
+    size_t mMemoryUsage = 0;
+    std::list<Entry> mEntries; /* most recently used first */
+    std::unordered_map<std::string, Iterator> mByName;
+    std::unordered_map<uint64_t, Iterator> mByHash;
+};
+
+NAMESPACE_END(nanogui)
@@ -0,0 +1,193 @@
+/*
+    nanogui/imageloader.h -- Per-context image loader decoding files on
+    worker threads
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/common.h>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class AsyncImageLoader imageloader.h nanogui/imageloader.h
+ *
+ * \brief Loads images of a NanoVG context without blocking the UI thread.
+ *
+ * Decoding PNG/JPEG files is by far the most expensive part of
+ * ``nvgCreateImage``. The loader decodes files on a small pool of worker
+ * threads and only uploads the finished pixels on the thread owning the
+ * context, at most \ref uploadBudget seconds per frame. Screens call
+ * \ref processUploads from their draw pass, so callers just have to
+ * \ref request an image and draw the returned placeholder until the real
+ * image arrives.
+ *
+ * There is one loader per NanoVG context. Apart from the worker threads it
+ * must only be used by the thread using the context.
+ */
+class NANOGUI_EXPORT AsyncImageLoader {
+public:
+    /// Called with the uploaded image, or 0 when the file could not be loaded
+    using Callback = std::function<void(int image)>;
+
+    /// Square RGBA thumbnail of a file, see \ref requestThumbnail
+    struct Thumbnail {
+        std::string path;
+        int size = 0;
+        /// ``size`` x ``size`` pixels, empty when the file could not be loaded
+        std::vector<uint8_t> rgba;
+    };
+    using ThumbnailCallback = std::function<void(const Thumbnail &thumbnail)>;
+
+    /// Fills ``rgba`` with ``width`` x ``height`` pixels on a worker thread, see \ref requestPixels
+    using Producer = std::function<bool(std::vector<uint8_t> &rgba, int &width, int &height)>;
+
+    /// Return the loader of ``ctx``, it is created on first use
+    static AsyncImageLoader &get(NVGcontext *ctx);
+
+    /// Return the loader of ``ctx`` if one was created, otherwise ``nullptr``
+    static AsyncImageLoader *find(NVGcontext *ctx);
+
+    /// Drop the loader of ``ctx`` (called before the context is deleted)
+    static void release(NVGcontext *ctx);
+
+    ~AsyncImageLoader();
+
+    /**
+     * \brief Request the image stored at ``path``.
+     *
+     * Returns the image right away if it was already uploaded (0 if the file
+     * could not be loaded). Otherwise the
+     * file is queued for decoding (once, no matter how often it is
+     * requested) and \ref placeholder is returned. ``callback`` is invoked on
+     * the UI thread once the image is available, also when it was loaded
+     * before. ``imageFlags`` are NanoVG image flags used for the upload.
+     */
+    int request(const std::string &path, const Callback &callback = nullptr,
+                int imageFlags = 0);
+
+    /**
+     * \brief Decode ``path`` into a ``size`` x ``size`` thumbnail.
+     *
+     * The image is cropped to a centered square and downscaled on a worker
+     * thread. Nothing is uploaded, the pixels are handed to ``callback`` on
+     * the UI thread (from \ref processUploads) so that they can be packed
+     * into an atlas.
+     */
+    void requestThumbnail(const std::string &path, int size,
+                          const ThumbnailCallback &callback);
+
+    /**
+     * \brief Run ``producer`` on a worker thread and upload its pixels.
+     *
+     * ``callback`` receives the new image on the UI thread, or 0 if the
+     * producer failed. Unlike \ref request, the image is not cached and
+     * belongs to the caller. Returns a ticket for \ref cancel.
+     */
+    uint64_t requestPixels(const Producer &producer, const Callback &callback,
+                           int imageFlags = 0);
+
+    /// Drop a \ref requestPixels or \ref requestThumbnail job, its callback won't be called
+    void cancel(uint64_t ticket);
+
+    /// Whether ``path`` is queued or being decoded
+    bool pending(const std::string &path) const { return mWaiting.count(path) != 0; }
+
+    /// Transparent 1x1 image returned by \ref request while a file loads
+    int placeholder();
+
+    /**
+     * \brief Upload decoded images and run their callbacks.
+     *
+     * Must be called from the thread using the context, with the context
+     * current. Stops once \ref uploadBudget is exceeded and returns whether
+     * decoded images are left for the next frame.
+     */
+    bool processUploads();
+
+    /// Number of images, thumbnails and pixel jobs queued, decoding or waiting for upload
+    size_t pendingCount() const {
+        return mWaiting.size() + mThumbnailCallbacks.size() + mPixelCallbacks.size();
+    }
+
+    double uploadBudget() const { return mUploadBudget; }
+    void setUploadBudget(double seconds) { mUploadBudget = seconds; }
+
+    int threadCount() const { return mThreadCount; }
+    /// Set the number of decode threads, takes effect before the first request
+    void setThreadCount(int count) { mThreadCount = std::max(count, 1); }
+
+private:
+    explicit AsyncImageLoader(NVGcontext *ctx);
+
+    /* Jobs with a positive thumbSize produce a thumbnail, jobs with a
+       producer run it instead of decoding a file */
+    struct Job {
+        std::string path;
+        int flags;
+        int thumbSize;
+        uint64_t ticket;
+        Producer producer;
+    };
+
+    struct Decoded {
+        Job job;
+        int width, height;
+        unsigned char *pixels;
+        std::vector<uint8_t> rgba;
+    };
+
+    void enqueue(Job &&job);
+    void startWorkers();
+    void workerLoop();
+
+    NVGcontext *mContext;
+    int mPlaceholder = 0;
+    int mThreadCount;
+    double mUploadBudget = 0.004;
+
+    /* Shared with the workers */
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<Job> mJobs;
+    std::deque<Decoded> mDecoded;
+    std::vector<std::thread> mWorkers;
+    bool mStop = false;
+
+    /* UI thread only */
+    std::unordered_map<std::string, int> mImages;
+    std::unordered_map<std::string, std::vector<Callback>> mWaiting;
+    std::unordered_map<uint64_t, ThumbnailCallback> mThumbnailCallbacks;
+    std::unordered_map<uint64_t, Callback> mPixelCallbacks;
+    uint64_t mNextTicket = 0;
+};
+
+/**
+ * \brief Asynchronous variant of \ref loadImageDirectory.
+ *
+ * Returns the matching files right away, each paired with the loader's
+ * placeholder. The images are decoded in the background, ``callback`` is
+ * invoked for every file once its image is uploaded. Widgets such as
+ * \ref ImagePanel swap in the real images by themselves.
+ */
+extern NANOGUI_EXPORT std::vector<std::pair<int, std::string>>
+    loadImageDirectoryAsync(NVGcontext *ctx, const std::string &path,
+                            std::function<void(int, const std::string&)> callback = nullptr,
+                            std::function<bool(const std::string&)> f = nullptr);
+
+NAMESPACE_END(nanogui)
@@ -30,10 +30,25 @@ public:
     RTTI_DECLARE_INFO(ImagePanel)
 
     ImagePanel(Widget *parent);
+    ~ImagePanel();
 
-    void setImages(const Images &data) { mImages = data; }
+    void setImages(const Images &data) { mImages = data; mAtlasReset = true; }
     const Images& images() const { return mImages; }
 
+    /**
+     * Whether thumbnails are drawn from shared atlas pages, off by default.
+     * Textures can't be read back, so each image is decoded again from its
+     * path and downscaled in the background (see \ref AsyncImageLoader);
+     * images without a loadable path are drawn individually from their
+     * texture. Only the thumbnails of pages kept on the GPU stay in memory.
+     */
+    bool useAtlas() const { return mUseAtlas; }
+    void setUseAtlas(bool useAtlas) { mUseAtlas = useAtlas; mAtlasReset = true; }
+
+    /// Number of atlas pages kept on the GPU, the least recently drawn page is reused first
+    size_t maxAtlasPages() const { return mMaxAtlasPages; }
+    void setMaxAtlasPages(size_t count) { mMaxAtlasPages = std::max<size_t>(count, 1); }
+
     std::function<void(int)> callback() const { return mCallback; }
     void setCallback(const std::function<void(int)> &callback) { mCallback = callback; }
 
@@ -42,8 +57,26 @@ public:
     virtual Vector2i preferredSize(NVGcontext *ctx) const override;
     virtual void draw(NVGcontext* ctx) override;
 protected:
+    enum ThumbnailState : uint8_t { ThumbnailNone, ThumbnailLoading, ThumbnailReady, ThumbnailFailed };
+
+    /// Texture holding the thumbnails of ``mAtlasRows`` grid rows, laid out like the grid
+    struct AtlasPage {
+        int index = -1;
+        int image = 0;
+        uint32_t lastUse = 0;
+        bool dirty = false;
+    };
+
     Vector2i gridSize() const;
     int indexForPosition(const Vector2i &p) const;
+    Vector2i cellPosition(size_t index, const Vector2i &grid) const;
+    void drawImage(NVGcontext *ctx, size_t index, const Vector2i &p);
+    void prepareAtlas(NVGcontext *ctx, int columns);
+    void releaseAtlasPages();
+    void releaseThumbnails();
+    void requestThumbnails(NVGcontext *ctx, size_t first, size_t last);
+    AtlasPage &atlasPage(NVGcontext *ctx, int index);
+    void bakeAtlasPage(NVGcontext *ctx, AtlasPage &page);
 protected:
     Images mImages;
     std::function<void(int)> mCallback;
@@ -51,6 +84,23 @@ protected:
     int mSpacing;
     int mMargin;
     int mMouseIndex;
+
+    bool mUseAtlas = false;
+    bool mAtlasReset = true;
+    bool mPruneThumbnails = false;
+    NVGcontext *mAtlasContext = nullptr;
+    std::vector<std::vector<uint8_t>> mThumbnails;
+    std::vector<uint8_t> mThumbnailState;
+    std::vector<AtlasPage> mAtlasPages;
+    size_t mMaxAtlasPages = 8;
+    uint32_t mAtlasFrame = 0;
+    uint32_t mAtlasGeneration = 0;
+    int mAtlasColumns = 0, mAtlasRows = 0;
+    /* Thumbnail size, grid stride and shadow margin in pixels */
+    int mAtlasThumbPx = 0, mAtlasStridePx = 0, mAtlasPadPx = 0;
+    /* Per-pixel coverage of the rounded thumbnail and its shadow within one cell */
+    std::vector<float> mCellCoverage, mCellShadow;
+    std::vector<uint8_t> mAtlasPixels;
 };
 
 NAMESPACE_END(nanogui)
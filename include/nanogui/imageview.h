@@ -15,7 +15,11 @@
 #pragma once
 
 #include <nanogui/widget.h>
+#include <nanogui/tilesource.h>
 #include <functional>
+#include <list>
+#include <vector>
+#include <unordered_map>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -34,6 +38,33 @@ public:
 
     void bindImage(uint32_t imageId);
 
+    /**
+     * \brief Display tightly packed RGBA8 pixels owned by this view.
+     *
+     * The first call creates a NanoVG image, later calls with the same size
+     * update it in place instead of allocating a new texture, the pixel info
+     * overlay is queried again. Must be called on the main thread while the
+     * widget is part of a screen.
+     */
+    void setImageData(int width, int height, const uint8_t *rgba);
+
+    /**
+     * \brief Display a tiled, multi-resolution image instead of a single texture.
+     *
+     * Only the tiles visible at the current scale are requested from
+     * ``source`` (on the worker threads of \ref AsyncImageLoader), plus a
+     * ring of tiles around the viewport. While a tile loads, the closest
+     * coarser tile that is available is stretched in its place. Passing
+     * ``nullptr`` returns to the bound image.
+     */
+    void setTileSource(TileSource *source);
+    TileSource *tileSource() { return mTileSource; }
+    const TileSource *tileSource() const { return mTileSource.get(); }
+
+    /// Number of tiles kept on the GPU, least recently drawn tiles are deleted first
+    size_t tileCacheCapacity() const { return mTileCacheCapacity; }
+    void setTileCacheCapacity(size_t capacity) { mTileCacheCapacity = std::max<size_t>(capacity, 1); }
+
     Vector2f positionF() const { return mPos.cast<float>(); }
     Vector2f sizeF() const { return mSize.cast<float>(); }
 
@@ -61,9 +92,58 @@ public:
     float pixelInfoThreshold() const { return mPixelInfoThreshold; }
     void setPixelInfoThreshold(float pixelInfoThreshold) { mPixelInfoThreshold = pixelInfoThreshold; }
 
+    /**
+     * \brief Values of a rectangle of pixels shown by the pixel info overlay.
+     *
+     * The view sets \ref origin and \ref size and sizes the buffers before
+     * passing the region to the callback, which fills them in.
+     */
+    struct PixelInfoRegion {
+        /// First pixel of the rectangle
+        Vector2i origin = Vector2i::Zero();
+        /// Number of pixels in each direction
+        Vector2i size = Vector2i::Zero();
+        /// Number of values shown per pixel, one per line (at most 4)
+        int channels = 4;
+        /// Digits after the decimal point
+        int precision = 3;
+        /// Four values per pixel, row by row; NaN values are not shown
+        std::vector<float> values;
+        /// Text color of each pixel
+        std::vector<Color> colors;
+    };
+
+    /**
+     * \brief Provide the pixel info overlay one rectangle at a time.
+     *
+     * The callback is invoked once for all visible pixels, and only again
+     * when the visible pixels or the image change, or after
+     * \ref invalidatePixelInfo. Takes precedence over the per pixel
+     * callback.
+     */
+    void setPixelInfoRegionCallback(const std::function<void(PixelInfoRegion &)> &callback) {
+        mPixelInfoRegionCallback = callback;
+        invalidatePixelInfo();
+    }
+    const std::function<void(PixelInfoRegion &)> &pixelInfoRegionCallback() const {
+        return mPixelInfoRegionCallback;
+    }
+
+    /**
+     * Query the pixel info again on the next frame. Needed when the pixels
+     * of a bound texture are changed in place; \ref setImageData does it.
+     */
+    void invalidatePixelInfo() { mPixelInfoCache.valid = false; }
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
+    /**
+     * Per pixel variant of \ref setPixelInfoRegionCallback. The results are
+     * cached the same way: the callback is only invoked again when the
+     * visible pixels or the image change, or after \ref invalidatePixelInfo.
+     */
     void setPixelInfoCallback(const std::function<std::pair<std::string, Color>(const Vector2i&)>& callback) {
         mPixelInfoCallback = callback;
+        invalidatePixelInfo();
     }
     const std::function<std::pair<std::string, Color>(const Vector2i&)>& pixelInfoCallback() const {
         return mPixelInfoCallback;
@@ -136,6 +216,10 @@ private:
     // Helper image methods.
     void updateImageParameters();
     void _internalDraw(NVGcontext* ctx);
+    void drawTiles(NVGcontext* ctx);
+    int tileImage(uint64_t key);
+    void requestTile(int level, int x, int y);
+    void releaseTiles();
 
     // Helper drawing methods.
     void drawWidgetBorder(NVGcontext* ctx) const;
@@ -144,13 +228,31 @@ private:
     static void drawPixelGrid(NVGcontext* ctx, const Vector2f& upperLeftCorner,
                               const Vector2f& lowerRightCorner, float stride);
     void drawPixelInfo(NVGcontext* ctx, float stride) const;
-    void writePixelInfo(NVGcontext* ctx, const Vector2f& cellPosition,
-                        const Vector2i& pixel, float stride, float fontSize) const;
+    void updatePixelInfo(const Vector2i& origin, const Vector2i& size) const;
 
     // Image parameters.
     uint32_t mImageID;
     Vector2i mImageSize;
 
+    // Image created by setImageData(), deleted with the view.
+    int mOwnedImage = 0;
+    NVGcontext *mOwnedImageContext = nullptr;
+
+    // Tiled image, see setTileSource().
+    struct Tile {
+        uint64_t key;
+        int image;
+        uint32_t lastUse;
+    };
+    ref<TileSource> mTileSource;
+    NVGcontext *mTileContext = nullptr;
+    std::list<Tile> mTiles; // most recently drawn first
+    std::unordered_map<uint64_t, std::list<Tile>::iterator> mTileIndex;
+    std::unordered_map<uint64_t, uint64_t> mPendingTiles; // key -> loader ticket
+    size_t mTileCacheCapacity = 256;
+    uint32_t mTileFrame = 0;
+    uint32_t mTileGeneration = 0;
+
     // Image display parameters.
     float mScale;
     Vector2f mOffset;
@@ -166,6 +268,22 @@ private:
 
     // Image pixel data display members.
     std::function<std::pair<std::string, Color>(const Vector2i&)> mPixelInfoCallback;
+    std::function<void(PixelInfoRegion &)> mPixelInfoRegionCallback;
+
+    // Text of the visible pixels, kept until they or the image change.
+    struct PixelInfoCache {
+        bool valid = false;
+        Vector2i origin = Vector2i::Zero();
+        Vector2i size = Vector2i::Zero();
+        uint32_t image = 0;
+        const TileSource *tiles = nullptr;
+        std::string text;                                // all lines back to back
+        std::vector<std::pair<uint32_t, uint32_t>> lines; // [begin, end) in text
+        std::vector<uint32_t> firstLine;                 // per pixel, plus one
+        std::vector<Color> colors;                       // per pixel
+    };
+    mutable PixelInfoCache mPixelInfoCache;
+    mutable PixelInfoRegion mPixelInfoRegion;
     float mFontScaleFactor = 0.2f;
 };
 
@@ -50,7 +50,7 @@ public:
     void setCaption(const std::string &caption) { mCaption = caption; }
 
     /// Set the currently active font (2 are available by default: 'sans' and 'sans-bold')
-    void setFont(const std::string &font) { mFont = font; }
+    void setFont(const std::string &font) { mFont = font; mFontHandle = -1; }
     /// Get the currently active font
     const std::string &font() const { return mFont; }
 
@@ -79,8 +79,12 @@ public:
     virtual void save(Serializer &s) const override;
     virtual bool load(Serializer &s) override;
 protected:
+    /// Resolve \ref mFont once, the handle is kept until the font changes
+    int fontHandle(NVGcontext *ctx) const;
+
     std::string mCaption;
     std::string mFont;
+    mutable int mFontHandle = -1;
     Color mColor, mDisabledColor;
     TextHAlign mTextHAlign = hLeft;
     TextVAlign mTextVAlign = vMiddle;
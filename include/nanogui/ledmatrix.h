@@ -57,6 +57,12 @@ public:
 
   Color colorAt(int row, int col) const;
   void setColorAt(int row, int col, const Color& rgb);
+  /**
+   * Set all LEDs at once from row-major ``0xRRGGBBAA`` values (see \ref LEDColor).
+   * ``rowStride`` is the distance between two rows in elements, values
+   * outside of the matrix are ignored.
+   */
+  void setColors(const uint32_t* colors, int rows, int columns, size_t rowStride);
   void clearColumn(int col);
 
   int rowCount() const;
@@ -13,20 +13,41 @@ public:
   ListboxItem(Widget* parent, const std::string& str);
   void performLayout(NVGcontext *ctx) override;
 
+  /// Index of the entry this row currently shows, rows are reused while scrolling
+  int index() const { return mIndex; }
+  void setIndex(int index) { mIndex = index; }
+
   void draw(NVGcontext *ctx) override;
   void beforeDoCallback() override;
+
+private:
+  int mIndex = -1;
 };
 
 
 DECLSETTER(ListboxCallback, std::function<void(ListboxItem*)>)
 DECLSETTER(ListboxContent, std::function<void(Listbox&)>)
 
+/**
+ * \class Listbox listbox.h nanogui/listbox.h
+ *
+ * \brief Scrollable list of fixed-height rows.
+ *
+ * Entries are plain data; only enough \ref ListboxItem rows to fill the
+ * viewport exist, and they are bound to other entries while scrolling. The
+ * entries either come from \ref addItem or from a model set with
+ * \ref setItemCount. The row passed to the selection callback is only
+ * valid until the list scrolls, use \ref ListboxItem::index to identify it.
+ */
 class NANOGUI_EXPORT Listbox : public Widget
 {
 public:
   RTTI_CLASS_UID("LSBX")
   RTTI_DECLARE_INFO(Listbox)
 
+  /// Sets up ``row`` (caption, id, icon...) to show entry ``index``
+  using BindRow = std::function<void(int index, ListboxItem *row)>;
+
   Listbox(Widget* parent);
 
   using Widget::set;
@@ -35,6 +56,20 @@ public:
     : Listbox(parent) { set<Listbox, Args...>(args...); }
 
   void addItem(const std::string& str, const std::string& id = "");
+
+  /// Show ``count`` entries provided by ``bind`` instead of the added items
+  void setItemCount(int count, const BindRow &bind);
+  int itemCount() const { return mItemCount; }
+
+  /// Remove all entries
+  void clear();
+
+  /// Height of a row, 0 measures the first row
+  int rowHeight() const { return mRowHeight; }
+  void setRowHeight(int height) { mRowHeight = height; }
+
+  /// Scroll so that entry ``index`` is at the top (or as close as possible)
+  void scrollToItem(int index);
   void performLayout(NVGcontext *ctx) override;
 
   void draw(NVGcontext* ctx) override;
@@ -46,9 +81,21 @@ public:
   void addContent(std::function<void(Listbox&)> f);
 
 private:
+  friend class ListboxRows;
+
+  struct Entry {
+    std::string caption;
+    std::string id;
+  };
+
   VScrollPanel* mPanel = nullptr;
   Widget* mItems = nullptr;
 
+  std::vector<Entry> mEntries;
+  int mItemCount = 0;
+  BindRow mBind;
+  int mRowHeight = 0;
+
   std::function<void(ListboxItem*)> mSelectCallback;
 
 public:
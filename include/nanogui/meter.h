@@ -94,6 +94,24 @@ protected:
     void drawValidWindow(NVGcontext *painter);
     void drawWarningWindow(NVGcontext *painter);
 
+    /* Geometry of the static parts of the face (ticks, scale labels and
+       threshold arc), rebuilt when the size, range or scale changes so
+       that a frame only computes the needle and the numeric value */
+    struct FaceCache {
+        bool valid = false;
+        Vector2i size = Vector2i::Zero();
+        float fontSize = 0.f;
+        /// Tick end points relative to the center, two per tick
+        std::vector<Vector2f> ticks;
+        std::vector<std::string> labels;
+        /// Top left corner of each label relative to the center
+        std::vector<Vector2f> labelPos;
+        float thresholdAngle = 0.f;
+    };
+    void updateFace(NVGcontext *ctx);
+    void invalidateFace() { mFace.valid = false; }
+    FaceCache mFace;
+
     std::string m_units;
     std::string m_label;
     std::string m_value_text;
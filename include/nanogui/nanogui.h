@@ -25,6 +25,7 @@
 #include <nanogui/popupbutton.h>
 #include <nanogui/contextmenu.h>
 #include <nanogui/combobox.h>
+#include <nanogui/virtuallist.h>
 #include <nanogui/progressbar.h>
 #include <nanogui/entypo.h>
 #include <nanogui/messagedialog.h>
@@ -37,7 +37,8 @@ public:
 
     int textureId() const;
     int mirrorTextureId();
-    void updateTextures( NVGcontext* ctx );
+    //! load pending textures set by path, returns true when the texture changed
+    bool updateTextures( NVGcontext* ctx );
 
     const std::string& text() const { return mText; }
     const std::string& tetrurePath() const { return mPath; }
@@ -48,6 +49,7 @@ private:
     int mDownTexture;
     std::string mPath; 
     std::string mText;
+    bool mLoading;
 };
 
 class NANOGUI_EXPORT Picflow : public Widget
@@ -59,9 +61,12 @@ public:
     Picflow(Widget* parent, const Vector2f& picrect);
 
     uint32_t addItem(int texture, const std::string& text = "", void* object = nullptr);
+    //! add an item whose image is loaded in the background, see AsyncImageLoader
+    uint32_t addItem(const std::string& path, const std::string& text = "", void* object = nullptr);
 
     void setMode(Mode mode) { mMode = mode; mNeedUpdateImages = true; }
     void setItemTexture( uint32_t index, int texture );
+    void setItemTexture( uint32_t index, const std::string& path );
     void setItemBlend( uint32_t index, int blend );
     void setItemFont( uint32_t index, const std::string& font );
 
@@ -95,6 +100,7 @@ public:
 
 protected:
 
+    //! index of the item drawn at a position in parent coordinates, -1 if there is none
     virtual int getItemAt(int xpos, int ypos) const;
  
     void _drawpair( NVGcontext* ctx, 
@@ -103,7 +109,7 @@ protected:
                          bool drawMirror=true );
 
     void _updaterects(NVGcontext* ctx);
-    void _updatepos();
+    bool _updatepos();
     Vector4i _correctRect( NVGcontext* ctx, int texture, const Vector4i& rectangle );
     void _drawimg( NVGcontext* painter, int txs, 
                    const Vector4f& rectabgle, Color* colors );
@@ -0,0 +1,109 @@
+/*
+    nanogui/pickbuffer.h -- Coarse grid of the shapes drawn in a frame
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/common.h>
+#include <vector>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class PickBuffer pickbuffer.h nanogui/pickbuffer.h
+ *
+ * \brief Answers "what is under the mouse" from what was drawn last frame.
+ *
+ * Every \ref Screen owns one and clears it at the start of each frame.
+ * While drawing, widgets with custom geometry register their parts
+ * (rectangles, rings, triangles) under an id of their choosing; event
+ * handlers then ask \ref pick for the id at a position instead of redoing
+ * the geometry. Shapes are binned into a grid of coarse cells, so a lookup
+ * only tests the few shapes overlapping one cell, topmost (last drawn)
+ * first.
+ *
+ * Separately, \ref widgetAt resolves the widget under a position like
+ * \ref Widget::findWidget, from a grid of the visible widget rectangles that
+ * is built on first use in a frame.
+ *
+ * All positions are absolute (screen) coordinates.
+ */
+class NANOGUI_EXPORT PickBuffer {
+public:
+    explicit PickBuffer(int cellSize = 32) : mCellSize(cellSize) { }
+
+    /// Forget all shapes, called by the screen before drawing a frame
+    void clear(Widget *root, const Vector2i &size);
+
+    /// Register the rectangle ``[x, y, z, w)``
+    void addRect(const Widget *widget, int id, const Vector4i &rect);
+
+    /// Register a ring between radius ``inner`` and ``outer`` (a disk if ``inner`` is 0)
+    void addCircle(const Widget *widget, int id, const Vector2f &center,
+                   float outer, float inner = 0.f);
+
+    /// Register a triangle
+    void addTriangle(const Widget *widget, int id, const Vector2f &a,
+                     const Vector2f &b, const Vector2f &c);
+
+    /// Id of the topmost shape of ``widget`` at ``p``, -1 if there is none
+    int pick(const Widget *widget, const Vector2i &p) const;
+
+    /// Whether ``widget`` registered any shape in the last frame
+    bool contains(const Widget *widget) const;
+
+    /// Widget under ``p`` as \ref Widget::findWidget would return it
+    Widget *widgetAt(const Vector2i &p);
+
+    /// Number of registered shapes
+    size_t size() const { return mShapes.size(); }
+
+private:
+    enum class Kind : uint8_t { Rect, Circle, Triangle };
+
+    struct Shape {
+        const Widget *widget;
+        int id;
+        Kind kind;
+        Vector4i bounds;
+        float data[6];
+    };
+
+    struct Entry {
+        Widget *widget;
+        Vector4i rect; // absolute rectangle, clipped by the ancestors
+    };
+
+    /* Lists of indices per cell, kept allocated between frames */
+    struct Grid {
+        Vector2i cells = Vector2i::Zero();
+        std::vector<std::vector<uint32_t>> lists;
+
+        void reset(const Vector2i &size, int cellSize);
+        void insert(uint32_t index, const Vector4i &bounds, int cellSize);
+        const std::vector<uint32_t> *at(const Vector2i &p, int cellSize) const;
+    };
+
+    void addShape(const Shape &shape);
+    static bool hit(const Shape &shape, const Vector2i &p);
+    void addWidgets(Widget *widget, const Vector2i &origin, const Vector4i &clip);
+
+    int mCellSize;
+    Vector2i mSize = Vector2i::Zero();
+    Widget *mRoot = nullptr;
+    std::vector<Shape> mShapes;
+    Grid mShapeGrid;
+    std::vector<Entry> mWidgets;
+    Grid mWidgetGrid;
+    bool mWidgetsValid = false;
+};
+
+NAMESPACE_END(nanogui)
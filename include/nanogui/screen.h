@@ -15,6 +15,11 @@
 #pragma once
 
 #include <nanogui/widget.h>
+#include <nanogui/pickbuffer.h>
+#include <limits>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -137,6 +142,10 @@ public:
     /// Return the last observed mouse position value
     Vector2i mousePos() const { return mMousePos; }
 
+    /// Shapes registered by the widgets while drawing the last frame
+    PickBuffer &pickBuffer() { return mPickBuffer; }
+    const PickBuffer &pickBuffer() const { return mPickBuffer; }
+
     /// Return a pointer to the underlying GLFW window data structure
     void *hwWindow() { return mHwWindow; }
 
@@ -162,6 +171,65 @@ public:
 
     template<typename... Args>Window& window(const Args&... args) { return wdg<Window>(args...); }
 
+    /// Mark the screen as dirty, it will be redrawn on the next main loop iteration
+    void requestRedraw() { mRedrawRequested = true; }
+
+    /**
+     * \brief Ask the main loop to redraw this screen after ``delay`` seconds.
+     *
+     * Widgets that animate (tooltip fade, spinners, scrolling) call this from
+     * their draw method for as long as the animation runs. Requests are
+     * paced to at most one frame per \ref frameInterval, and an idle screen
+     * without pending requests or input is not redrawn at all.
+     */
+    void requestAnimationFrame(double delay = 0.0);
+
+    /**
+     * \brief Run ``command`` on the main thread at the start of the next frame.
+     *
+     * This is the way to update widgets from background threads: the
+     * command is queued under a short lock and the main loop is woken up,
+     * it then executes all queued commands in order before laying out and
+     * drawing this screen. May be called from any thread.
+     */
+    void post(const std::function<void()> &command) { post(nullptr, command); }
+
+    /**
+     * \brief Queue a command that replaces a still pending one with the same key.
+     *
+     * Use e.g. the address of the updated widget as ``key`` for high-rate
+     * value updates: only the most recent command per key and frame runs,
+     * at the position of the first one. A ``nullptr`` key never coalesces.
+     */
+    void post(const void *key, const std::function<void()> &command);
+
+    /// Execute the commands queued via \ref post (called by the main loop)
+    void processPostedCommands();
+
+    /// Return whether this screen has to be redrawn at time ``now``
+    bool redrawPending(double now) const {
+        return mRedrawRequested || mCommandsPosted || now >= mNextAnimationTime;
+    }
+
+    /// Return the time of the earliest pending animation request (infinity if none)
+    double nextAnimationTime() const { return mNextAnimationTime; }
+
+    /// Minimal time in seconds between two animation frames of this screen
+    double frameInterval() const { return mFrameInterval; }
+    void setFrameInterval(double interval) { mFrameInterval = interval; }
+
+    /**
+     * \brief Time in seconds a single frame may spend on queued layouts.
+     *
+     * Once the budget is used up, the remaining widgets stay queued and are
+     * laid out on the following frames, so that the main loop gets to
+     * process input in between instead of stalling on a large relayout.
+     * At least one queued widget is laid out per frame. The default of 0
+     * disables the budget.
+     */
+    double layoutBudget() const { return mLayoutBudget; }
+    void setLayoutBudget(double seconds) { mLayoutBudget = seconds; }
+
 public:
     /********* API for applications which manage GLFW themselves *********/
 
@@ -197,6 +265,17 @@ public:
     void centerWindow(Window *window);
     void moveWindowToFront(Window *window);
     void drawWidgets();
+    void clearRedrawRequests(double now);
+
+    /**
+     * \brief Lay out all widgets queued via \ref needPerformLayout.
+     *
+     * Called at the start of \ref drawWidgets. Only touches this screen's
+     * widget tree and its own NanoVG context (text metrics), no graphics API
+     * calls are issued, so the main loop may run it for several screens
+     * concurrently (see \ref appSetParallelLayout).
+     */
+    void performPendingLayout();
     intptr_t createStandardCursor(int shape);
 
 protected:
@@ -221,8 +300,25 @@ protected:
     std::string mCaption;
     bool mShutdownOnDestruct;
     bool mFullscreen;
-    std::vector<Widget*> widgetsNeedUpdate;
+    std::vector<ref<Widget>> widgetsNeedUpdate; // in the order layouts were requested
+    bool mSelfNeedsLayout = false;
     std::function<void(Vector2i)> mResizeCallback;
+    bool mRedrawRequested = true;
+    double mNextAnimationTime = std::numeric_limits<double>::infinity();
+    double mLastDrawTime = 0.0;
+    double mFrameInterval = 1.0 / 60.0;
+    double mLayoutBudget = 0.0;
+    uint32_t mThemeVersion = 0;
+    PickBuffer mPickBuffer;
+
+    struct PostedCommand {
+        const void *key;
+        std::function<void()> command;
+    };
+    std::mutex mPostedMutex;
+    std::vector<PostedCommand> mPostedCommands;
+    std::unordered_map<const void*, size_t> mPostedIndex;
+    std::atomic<bool> mCommandsPosted { false };
 };
 
 NAMESPACE_END(nanogui)
@@ -92,12 +92,15 @@ struct serialization_helper<GLShader> {
                 s.pop();
 
                 size_t totalSize = (size_t) buf.size * (size_t) buf.compSize;
+                buf.capacity = totalSize;
                 if (key == "indices") {
+                    buf.target = GL_ELEMENT_ARRAY_BUFFER;
                     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buf.id);
                     glBufferData(GL_ELEMENT_ARRAY_BUFFER, totalSize,
                                  (void *) data.data(), GL_DYNAMIC_DRAW);
                 } else {
                     int attribID = value->attrib(key);
+                    buf.attribID = attribID;
                     glEnableVertexAttribArray(attribID);
                     glBindBuffer(GL_ARRAY_BUFFER, buf.id);
                     glBufferData(GL_ARRAY_BUFFER, totalSize, (void *) data.data(),
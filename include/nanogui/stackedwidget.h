@@ -16,6 +16,7 @@
 #pragma once
 
 #include <nanogui/widget.h>
+#include <functional>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -23,6 +24,11 @@ NAMESPACE_BEGIN(nanogui)
  * \class StackedWidget stackedwidget.h nanogui/stackedwidget.h
  *
  * \brief A stack widget.
+ *
+ * Only the selected page is laid out; the other pages are laid out when they
+ * are shown. Pages added with \ref addLazyPage are empty until they are
+ * shown for the first time and can be unloaded again when they have not been
+ * shown for a while (see \ref setMaxLoadedPages).
  */
 class NANOGUI_EXPORT StackedWidget : public Widget {
 public:
@@ -31,15 +37,68 @@ public:
 
     StackedWidget(Widget* parent);
 
+    /// Fills the (empty) widget of a lazy page
+    using PageFactory = std::function<void(Widget *page)>;
+
     void setSelectedIndex(int index);
     int selectedIndex() const;
 
+    /**
+     * \brief Add a page whose contents are created when it is first shown.
+     *
+     * Returns the page widget, which stays empty until ``factory`` is called
+     * on it. Until then ``sizeHint`` stands in for its preferred size.
+     */
+    Widget *addLazyPage(int index, const PageFactory &factory,
+                        const Vector2i &sizeHint = Vector2i::Zero());
+    Widget *addLazyPage(const PageFactory &factory,
+                        const Vector2i &sizeHint = Vector2i::Zero()) {
+        return addLazyPage(childCount(), factory, sizeHint);
+    }
+
+    /// Whether the contents of page ``index`` currently exist
+    bool isPageBuilt(int index) const { return mPages[index].built; }
+
+    /**
+     * \brief Maximum number of lazy pages whose contents are kept.
+     *
+     * When more are built, the contents of the least recently shown ones are
+     * removed and recreated by their factory the next time they are shown.
+     * Pointers into an unloaded page become invalid. 0 (the default) never
+     * unloads anything.
+     */
+    int maxLoadedPages() const { return mMaxLoadedPages; }
+    void setMaxLoadedPages(int count);
+
+    /// Measure page ``index`` again, inactive pages otherwise reuse their last size
+    void invalidatePageSize(int index) { mPages[index].preferredValid = false; }
+
     virtual void performLayout(NVGcontext* ctx) override;
     virtual Vector2i preferredSize(NVGcontext* ctx) const override;
+    virtual void draw(NVGcontext* ctx) override;
     virtual void addChild(int index, Widget* widget) override;
+    virtual void removeChild(int index) override;
+    virtual void removeChild(const Widget *widget) override;
 
 private:
+    struct Page {
+        PageFactory factory;
+        bool built = true;
+        bool layoutDirty = true;
+        int lastShown = 0;
+        /* Preferred size of the page when it was last measured */
+        mutable Vector2i preferred = Vector2i::Zero();
+        mutable bool preferredValid = false;
+    };
+
+    void buildPage(int index);
+    void unloadPage(int index);
+    void unloadPages();
+
     int mSelectedIndex = -1;
+    std::vector<Page> mPages;
+    int mMaxLoadedPages = 0;
+    int mShowCounter = 0;
 };
 
 NAMESPACE_END(nanogui)
@@ -35,7 +35,7 @@ public:
 
     TabHeader(Widget *parent, const std::string &font = "sans-bold");
 
-    void setFont(const std::string& font) { mFont = font; }
+    void setFont(const std::string& font) { mFont = font; mFontHandle = -1; }
     const std::string& font() const { return mFont; }
     bool overflowing() const { return mOverflowing; }
 
@@ -165,6 +165,8 @@ private:
     void calculateVisibleEnd();
 
     void drawControls(NVGcontext* ctx);
+    /// Resolve \ref mFont once, the handle is kept until the font changes
+    int fontHandle(NVGcontext* ctx) const;
     ClickLocation locateClick(const Vector2i& p);
     void onArrowLeft();
     void onArrowRight();
@@ -177,6 +179,7 @@ private:
     bool mOverflowing = false;
 
     std::string mFont;
+    mutable int mFontHandle = -1;
 };
 
 NAMESPACE_END(nanogui)
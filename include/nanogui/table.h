@@ -1,12 +1,17 @@
 #pragma once
 
 #include <nanogui/widget.h>
+#include <nanogui/textindex.h>
+#include <atomic>
 #include <bitset>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 NAMESPACE_BEGIN(nanogui)
 
 class ScrollBar;
+class Screen;
 class TextBox;
 
 class NANOGUI_EXPORT Table : public Widget
@@ -53,6 +58,28 @@ public:
     roCount
   };
 
+  //! value types a column can hold, see setColumnType
+  enum ColumnType
+  {
+    //! Cells keep the text they are given
+    ctText,
+
+    //! Signed 64 bit integers
+    ctInt64,
+
+    //! Doubles shown with a fixed number of decimals
+    ctDouble,
+
+    //! Seconds since the epoch, shown in local time
+    ctTimestamp,
+
+    //! Integers shown as the name at that index
+    ctEnum,
+
+    //! Not used as type, only to get maximum value for this enum
+    ctCount
+  };
+
   enum DrawFlag
   {
     drawRows = 0,
@@ -62,6 +89,27 @@ public:
     drawBorder = 4,
     drawCount
   } ;
+  //! One cell change for pushUpdates, holds text or a number
+  struct CellUpdate
+  {
+    enum Kind { Text, Int, Double };
+
+    CellUpdate(uint32_t row, uint32_t column, const std::string& text)
+      : row(row), column(column), kind(Text), text(text) {}
+    CellUpdate(uint32_t row, uint32_t column, int64_t value)
+      : row(row), column(column), kind(Int), intValue(value) {}
+    CellUpdate(uint32_t row, uint32_t column, int value)
+      : CellUpdate(row, column, (int64_t)value) {}
+    CellUpdate(uint32_t row, uint32_t column, double value)
+      : row(row), column(column), kind(Double), doubleValue(value) {}
+
+    uint32_t row, column;
+    Kind kind;
+    std::string text;
+    int64_t intValue = 0;
+    double doubleValue = 0.0;
+  };
+
   //! constructor
   Table( Widget* parent,
        const std::string& id, const Vector4i& rectangle, bool clip=true,
@@ -134,9 +182,43 @@ public:
     not at the end, there might be performance issues*/
   virtual uint32_t addRow(uint32_t rowIndex);
 
+  //! Appends count empty rows, returns the index of the first one
+  virtual uint32_t appendRows(uint32_t count);
+
   //! Remove a row from the table
   virtual void removeRow(uint32_t rowIndex);
 
+  //! Defer the recalculation of rows, cells and scrollbars until the
+  //! matching endUpdate(). Calls may nest, the geometry is updated once
+  //! when the outermost endUpdate() is reached.
+  void beginUpdate();
+  void endUpdate();
+
+  //! Returns true between beginUpdate() and the matching endUpdate()
+  bool isUpdating() const { return _updateLock > 0; }
+
+  //! Fill a column from count contiguous values, starting at firstRow.
+  //! Missing rows are appended, the geometry is updated once.
+  virtual void setColumnData(uint32_t columnIndex, const std::string* values, size_t count, uint32_t firstRow=0);
+  void setColumnData(uint32_t columnIndex, const std::vector<std::string>& values, uint32_t firstRow=0)
+  {
+    setColumnData(columnIndex, values.data(), values.size(), firstRow);
+  }
+
+  //! Numeric variants of setColumnData. Typed columns store the values,
+  //! text columns show doubles with precision decimals.
+  virtual void setColumnData(uint32_t columnIndex, const double* values, size_t count, uint32_t firstRow=0, int precision=2);
+  void setColumnData(uint32_t columnIndex, const std::vector<double>& values, uint32_t firstRow=0, int precision=2)
+  {
+    setColumnData(columnIndex, values.data(), values.size(), firstRow, precision);
+  }
+
+  virtual void setColumnData(uint32_t columnIndex, const int64_t* values, size_t count, uint32_t firstRow=0);
+  void setColumnData(uint32_t columnIndex, const std::vector<int64_t>& values, uint32_t firstRow=0)
+  {
+    setColumnData(columnIndex, values.data(), values.size(), firstRow);
+  }
+
   //! clear the table rows, but keep the columns intact
   virtual void clearRows();
 
@@ -152,6 +234,67 @@ public:
   virtual void orderRows(int columnIndex=-1, RowOrder mode=roNone);
 
 
+  //! Set the type of the values in a column. Typed columns keep their values
+  //! in one contiguous vector per column, and the text of a cell is only
+  //! formatted when it is drawn after a change. Sorting compares the values,
+  //! filtering matches their text. Existing texts are parsed when a column
+  //! gets a type, values are formatted once when it goes back to ctText.
+  virtual void setColumnType(uint32_t columnIndex, ColumnType type);
+
+  //! Returns the type of a column
+  virtual ColumnType getColumnType(uint32_t columnIndex) const;
+
+  //! Number of decimals shown for a ctDouble column
+  virtual void setColumnPrecision(uint32_t columnIndex, int precision);
+
+  //! strftime format used by a ctTimestamp column
+  virtual void setColumnTimeFormat(uint32_t columnIndex, const std::string& format);
+
+  //! Names shown by a ctEnum column, values outside the list show as numbers
+  virtual void setColumnEnumNames(uint32_t columnIndex, const std::vector<std::string>& names);
+
+  //! Set the value of a cell. Typed columns store it as is (converted to the
+  //! column type), text columns store its text.
+  virtual void setCellInt(uint32_t rowIndex, uint32_t columnIndex, int64_t value);
+  virtual void setCellDouble(uint32_t rowIndex, uint32_t columnIndex, double value);
+
+  //! Get the value of a cell in a typed column, 0 for text columns
+  virtual int64_t getCellInt(uint32_t rowIndex, uint32_t columnIndex) const;
+  virtual double getCellDouble(uint32_t rowIndex, uint32_t columnIndex) const;
+
+  //! Queue cell changes for the next frame, may be called from any thread.
+  //! Changes are merged per cell (the latest wins) and applied together in
+  //! one batch at the start of the next frame, so a feed updating faster
+  //! than the frame rate costs one pass per frame. Applied changes flash
+  //! the cell, see setHighlightDuration. The table must be part of a screen
+  //! when created or drawn, changes pushed before are applied with the next push.
+  void pushUpdates(const std::vector<CellUpdate>& updates);
+  void pushUpdate(const CellUpdate& update) { pushUpdates({ update }); }
+
+  //! Seconds a cell changed by pushUpdates stays highlighted, 0 disables it
+  void setHighlightDuration(float seconds) { _highlightDuration = seconds; }
+  float getHighlightDuration() const { return _highlightDuration; }
+
+  //! Color of the highlight, it fades out over the highlight duration
+  void setHighlightColor(const Color& color) { _highlightColor = color; }
+  const Color& getHighlightColor() const { return _highlightColor; }
+
+  //! Show only the rows containing query in any cell (case-insensitive),
+  //! an empty query shows all rows again. The cell texts are kept in a
+  //! trigram index, and a query extending the previous one only checks
+  //! the rows matched so far, so filtering as the user types stays cheap.
+  //! Rows whose cells change are indexed and checked again on the next frame.
+  virtual void setFilter(const std::string& query);
+
+  //! Returns the current filter query
+  const std::string& getFilter() const { return _filter; }
+
+  //! Returns the number of rows passing the filter
+  int getVisibleRowCount() const;
+
+  //! Returns the row shown at position visibleIndex, -1 if out of range
+  int getVisibleRow(int visibleIndex) const;
+
   //! Set the text of a cell
   virtual void setCellText(uint32_t rowIndex, uint32_t columnIndex, const std::string& text);
 
@@ -236,6 +379,35 @@ private:
   int _getCurrentColumn(int xpos, int ypos );
   void _recalculateCells();
 
+  //! parts of the geometry to recalculate, see _requestUpdate
+  enum UpdateFlag
+  {
+    updColumns = 1 << 0,
+    updHeights = 1 << 1,
+    updCells = 1 << 2,
+    updScrollBars = 1 << 3,
+    updFilter = 1 << 4
+  };
+
+  //! recalculate now, or at endUpdate() when inside a batch
+  void _requestUpdate(uint32_t flags);
+
+  //! keep the filter index in sync with row changes
+  void _rowAdded(uint32_t rowIndex);
+  void _rowTextChanged(uint32_t rowIndex);
+  void _rowsMoved();
+  void _applyFilter();
+  std::string _rowText(uint32_t rowIndex) const;
+
+  class Cell;
+  class Column;
+  Cell* _newCell(const Column* column);
+  std::string _formatValue(const Column* column, uint32_t rowIndex) const;
+  void _parseValue(Column* column, uint32_t rowIndex, const std::string& text);
+  void _syncView(NVGcontext* ctx);
+  void _formatVisibleCells();
+  void _applyPushedUpdates();
+
   bool _clip;
   bool _moveOverSelect;
   bool _selecting;
@@ -254,9 +426,8 @@ private:
   int _activeTab;
   RowOrder _currentOrdering;
 
-  class Cell;
-  class Column;
   class HidingElement;
+  class ItemsArea;
   struct Row { std::vector<Cell*> items; };
 
   typedef std::vector<Column*> Columns;
@@ -270,11 +441,49 @@ private:
 
   Widget* _header;
   TextBox* _edit = nullptr;
-  Widget* _itemsArea;
+  ItemsArea* _itemsArea;
   ScrollBar* _verticalScrollBar;
   ScrollBar* _horizontalScrollBar;
-  bool _needRefreshCellsGeometry;
+  bool _needRefreshCellsGeometry = false;
   uint32_t _cellLastTimeClick;
+  int _updateLock = 0;
+  uint32_t _pendingUpdate = 0;
+
+  std::string _filter;
+  TextIndex _filterIndex;
+  bool _filterIndexValid = false;
+  //! rows changed since they were indexed, indexed again by _applyFilter
+  std::vector<uint32_t> _dirtyIndexRows;
+  std::vector<bool> _indexRowDirty;
+  //! cells changed while a filter is set, it is applied again on next draw
+  bool _filterStale = false;
+  //! rows passing the filter in display order, used when _filter is set
+  std::vector<uint32_t> _visibleRows;
+
+  //! part of the items area in view, cells outside are hidden and neither
+  //! placed, formatted nor drawn
+  int _viewTop = 0;
+  int _viewBottom = 0;
+
+  //! cells of the visible rows [_shownFirst, _shownLast), placed by _syncView
+  std::vector<ref<Cell>> _shownCells;
+  int _shownFirst = 0;
+  int _shownLast = 0;
+  //! rows, columns or the filter changed, the shown cells must be placed again
+  bool _viewDirty = true;
+
+  //! changes queued by pushUpdates, one entry per cell
+  std::mutex _pushedMutex;
+  std::vector<CellUpdate> _pushed;
+  std::unordered_map<uint64_t, size_t> _pushedIndex;
+  std::atomic<bool> _updatesPosted { false };
+  //! screen of the table, resolved on the UI thread for pushUpdates
+  std::atomic<Screen*> _screen { nullptr };
+
+  float _highlightDuration = 0.6f;
+  Color _highlightColor = Color(0xff, 0xc0, 0x00, 0x80);
+  float _drawTime = 0.f;
+  float _highlightEnd = 0.f;
 
   int _vscrollsize = 0;
   int _hscrollsize = 0;
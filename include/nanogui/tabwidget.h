@@ -15,7 +15,7 @@
 
 #pragma once
 
-#include <nanogui/widget.h>
+#include <nanogui/stackedwidget.h>
 #include <functional>
 
 NAMESPACE_BEGIN(nanogui)
@@ -96,6 +96,20 @@ public:
     Widget *createTab(const std::string &label);
     Widget *createTab(int index, const std::string &label);
 
+    /**
+     * \brief Creates a tab whose contents are built by ``factory`` when the
+     *        tab is first activated. See \ref StackedWidget::addLazyPage.
+     */
+    Widget *createLazyTab(const std::string &label, const StackedWidget::PageFactory &factory,
+                          const Vector2i &sizeHint = Vector2i::Zero());
+    Widget *createLazyTab(int index, const std::string &label,
+                          const StackedWidget::PageFactory &factory,
+                          const Vector2i &sizeHint = Vector2i::Zero());
+
+    /// Maximum number of lazy tabs whose contents are kept, see \ref StackedWidget::setMaxLoadedPages
+    int maxLoadedTabs() const { return mContent->maxLoadedPages(); }
+    void setMaxLoadedTabs(int count) { mContent->setMaxLoadedPages(count); }
+
     /// Inserts a tab at the end of the tabs collection and associates it with the provided widget.
     void addTab(const std::string &label, Widget *tab);
 
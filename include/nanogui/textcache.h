@@ -0,0 +1,154 @@
+/*
+    nanogui/textcache.h -- Per-context cache of measured and line-broken text
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/fontregistry.h>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+NAMESPACE_BEGIN(nanogui)
+
+/// Measured layout of a string, see \ref TextLayoutCache
+struct TextRun {
+    /// One line of a wrapped run, offsets are byte positions into the string
+    struct Row {
+        size_t start, end;
+        float width;
+    };
+
+    /// Horizontal advance as returned by ``nvgTextBounds``
+    float advance = 0.f;
+    /// Bounding box (xmin, ymin, xmax, ymax) of the text placed at the origin
+    float bounds[4] = { 0.f, 0.f, 0.f, 0.f };
+    /// Line breaks, only filled in for runs with a break width
+    std::vector<Row> rows;
+    /// Vertical distance between two rows
+    float lineAdvance = 0.f;
+    /// Break width and alignment the run was measured with
+    float breakWidth = 0.f;
+    int align = 0;
+    /// Byte offset and pen position of every glyph, filled in by \ref TextLayoutCache::fit
+    std::vector<size_t> glyphOffsets;
+    std::vector<float> glyphX;
+};
+
+/// Where an ellipsis is placed when text has to be shortened
+enum class Ellipsis { Start, Middle, End };
+
+/**
+ * \brief Result of \ref TextLayoutCache::fit.
+ *
+ * The displayed text is ``text[0, headEnd)``, followed by the ellipsis if
+ * \ref truncated is set, followed by ``text[tailStart, size)``.
+ */
+struct TextFit {
+    size_t headEnd = 0;
+    size_t tailStart = 0;
+    /// Width of the head part, i.e. where the ellipsis starts
+    float headWidth = 0.f;
+    /// Width of the whole displayed text including the ellipsis
+    float width = 0.f;
+    bool truncated = false;
+};
+
+/**
+ * \class TextLayoutCache textcache.h nanogui/textcache.h
+ *
+ * \brief Caches text measurements and line breaks of a NanoVG context.
+ *
+ * Fonts are given as \ref FontRegistry handles.
+ *
+ * Widgets measure their captions in ``preferredSize`` and again in every
+ * ``draw`` call, although the text rarely changes. The cache keeps the
+ * result per (font, size, alignment, line height, break width, string) and
+ * evicts the least recently used runs once \ref capacity is exceeded.
+ *
+ * There is one cache per NanoVG context. Like the context itself, a cache
+ * must only be used by one thread at a time.
+ */
+class NANOGUI_EXPORT TextLayoutCache {
+public:
+    /// Return the cache of ``ctx``, it is created on first use
+    static TextLayoutCache &get(NVGcontext *ctx);
+
+    /// Drop the cache of ``ctx`` (called before the context is deleted)
+    static void release(NVGcontext *ctx);
+
+    /**
+     * \brief Measure ``text`` and return the cached run.
+     *
+     * Sets font face, size, alignment and line height of the context, so
+     * the caller can draw the text right away. With a positive
+     * ``breakWidth`` the text is wrapped like ``nvgTextBox`` does and the
+     * bounds cover all rows. The returned reference stays valid until the
+     * next call to \ref measure.
+     */
+    const TextRun &measure(int font, float size, int align,
+                           const std::string &text, float breakWidth = 0.f,
+                           float lineHeight = 1.f);
+
+    /// Variant of \ref measure resolving ``font`` through the \ref FontRegistry
+    const TextRun &measure(const char *font, float size, int align,
+                           const std::string &text, float breakWidth = 0.f,
+                           float lineHeight = 1.f);
+
+    /**
+     * \brief Shorten single-line ``text`` with an ellipsis so it fits ``maxWidth``.
+     *
+     * The glyph positions of the text are measured once and cached with the
+     * run, finding the cut is then a binary search over them. Text that
+     * already fits is returned unchanged. Like \ref measure, this applies
+     * the font state to the context.
+     */
+    TextFit fit(int font, float size, int align, const std::string &text,
+                float maxWidth, Ellipsis mode = Ellipsis::End,
+                const char *ellipsis = "...");
+
+    /// Convenience wrapper around \ref fit returning the displayed string
+    std::string elide(int font, float size, int align, const std::string &text,
+                      float maxWidth, Ellipsis mode = Ellipsis::End,
+                      const char *ellipsis = "...");
+
+    /// Draw a wrapped run, equivalent to ``nvgTextBox`` with the measured state
+    void drawBox(float x, float y, const TextRun &run, const std::string &text) const;
+
+    /// Drop all runs measured with ``font`` (e.g. after its fallbacks changed)
+    void invalidateFont(int font);
+
+    size_t capacity() const { return mCapacity; }
+    void setCapacity(size_t capacity);
+
+    size_t size() const { return mRuns.size(); }
+    void clear();
+
+private:
+    explicit TextLayoutCache(NVGcontext *ctx) : mContext(ctx) {}
+    TextRun &lookup(int font, float size, int align, const std::string &text,
+                    float breakWidth, float lineHeight);
+
+    struct Entry {
+        uint64_t key;
+        int font;
+        float size, lineHeight;
+        std::string text;
+        TextRun run;
+    };
+
+    NVGcontext *mContext;
+    size_t mCapacity = 4096;
+    std::list<Entry> mRuns; /* most recently used first */
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> mIndex;
+};
+
+NAMESPACE_END(nanogui)
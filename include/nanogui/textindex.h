@@ -0,0 +1,69 @@
+/*
+    nanogui/textindex.h -- Trigram index for substring search in item lists
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/common.h>
+#include <unordered_map>
+#include <vector>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class TextIndex textindex.h nanogui/textindex.h
+ *
+ * \brief Case-insensitive substring search over a list of strings.
+ *
+ * Every string is split into overlapping trigrams. A query is answered by
+ * intersecting the (sorted) lists of strings containing each trigram of the
+ * query and verifying the few remaining candidates. Queries shorter than
+ * three characters scan all strings. When a query extends the previous one
+ * (as while typing), only the previous matches are checked.
+ *
+ * Case folding only covers ASCII, other bytes are compared as they are.
+ */
+class NANOGUI_EXPORT TextIndex {
+public:
+    TextIndex() = default;
+    explicit TextIndex(const std::vector<std::string> &strings) { build(strings); }
+
+    /// Index ``strings``, replacing the previous contents
+    void build(const std::vector<std::string> &strings);
+
+    /// Index one more string, it gets the next index
+    void append(const std::string &str);
+
+    /// Replace the string at ``index``, only its trigrams are touched
+    void update(uint32_t index, const std::string &str);
+
+    /// Number of indexed strings
+    size_t size() const { return mStrings.size(); }
+
+    /// Indices of all strings containing ``query`` in increasing order
+    const std::vector<uint32_t> &search(const std::string &query);
+
+private:
+    static std::string fold(const std::string &str);
+    void addPostings(uint32_t index);
+    static uint32_t trigram(const char *str) {
+        return (uint32_t) (uint8_t) str[0] << 16 | (uint32_t) (uint8_t) str[1] << 8 |
+               (uint32_t) (uint8_t) str[2];
+    }
+
+    std::vector<std::string> mStrings; /* case folded */
+    std::unordered_map<uint32_t, std::vector<uint32_t>> mPostings;
+    std::string mLastQuery;
+    std::vector<uint32_t> mLastResult;
+    bool mHasLastResult = false;
+};
+
+NAMESPACE_END(nanogui)
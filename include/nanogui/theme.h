@@ -19,6 +19,8 @@
 #include <nanogui/common.h>
 #include <nanogui/object.h>
 #include <string.h>
+#include <vector>
+#include <utility>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -50,6 +52,40 @@ public:
     int get(const std::string& name, const int&);
     void set(const std::string& name, const int& v);
 
+    float get(const std::string& name, const float&);
+    void set(const std::string& name, const float& v);
+
+    /// Return whether ``name`` is a property accessible via \ref get and \ref set
+    static bool hasProperty(const std::string& name);
+
+    /**
+     * \brief Counter incremented on every change made through this interface.
+     *
+     * Widgets can keep paints or sizes derived from the theme until the
+     * version changes. Call \ref touch after assigning members directly.
+     */
+    uint32_t version() const { return mVersion; }
+    void touch() { ++mVersion; }
+
+    /// A batch of property changes, see \ref apply
+    struct Diff {
+        Diff& set(const std::string& name, int v) { mInts.emplace_back(name, v); return *this; }
+        Diff& set(const std::string& name, float v) { mFloats.emplace_back(name, v); return *this; }
+        Diff& set(const std::string& name, const Color& v) { mColors.emplace_back(name, v); return *this; }
+
+        std::vector<std::pair<std::string, int>> mInts;
+        std::vector<std::pair<std::string, float>> mFloats;
+        std::vector<std::pair<std::string, Color>> mColors;
+    };
+
+    /**
+     * \brief Apply all changes of ``diff`` with a single version increment.
+     *
+     * All names are validated first, so an unknown property throws without
+     * leaving the theme partially modified.
+     */
+    void apply(const Diff& diff);
+
     /* Fonts */
     /// The standard font face (default: ``"sans"`` from ``resources/roboto_regular.ttf``).
     int mFontNormal;
@@ -293,6 +329,8 @@ protected:
     /// Default destructor does nothing; allows for inheritance.
     virtual ~Theme() { }
     Theme() {}
+
+    uint32_t mVersion = 0;
 };
 
 class NANOGUI_EXPORT DefaultTheme : public Theme
@@ -0,0 +1,136 @@
+/*
+    nanogui/tilesource.h -- Tiled, multi-resolution image data for ImageView
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/object.h>
+#include <nanogui/common.h>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class TileSource tilesource.h nanogui/tilesource.h
+ *
+ * \brief Supplies the pixels of images too large for a single texture.
+ *
+ * The image is split into square tiles of \ref tileSize pixels on a
+ * pyramid of resolution levels. Level 0 is the full resolution, every
+ * further level halves it, the last level fits into a single tile. Tiles
+ * are RGBA8, tightly packed; parts outside of the image stay transparent.
+ *
+ * \ref readTile is called from worker threads, possibly concurrently.
+ */
+class NANOGUI_EXPORT TileSource : public Object {
+public:
+    TileSource(const Vector2i &size, int tileSize = 256);
+
+    /// Size of the full resolution image
+    const Vector2i &size() const { return mSize; }
+    int tileSize() const { return mTileSize; }
+    int levelCount() const { return mLevelCount; }
+
+    /// Size of the image at ``level``
+    Vector2i levelSize(int level) const;
+
+    /// Number of tiles in each direction at ``level``
+    Vector2i tileCount(int level) const;
+
+    /**
+     * \brief Fill ``rgba`` (\ref tileSize squared pixels) with a tile.
+     *
+     * The default implementation reads level 0 through \ref readRegion and
+     * box filters the four tiles of the next finer level for the others.
+     * Reduced tiles are kept in a bounded cache (see \ref pyramidCacheSize),
+     * so a coarse tile is built from the four cached tiles below it instead
+     * of from the full resolution image. Sources with a precomputed pyramid
+     * should override this.
+     */
+    virtual bool readTile(int level, int x, int y, uint8_t *rgba);
+
+    /// Memory in bytes kept for reduced tiles, the least recently read are dropped first
+    size_t pyramidCacheSize() const { return mPyramidCacheSize; }
+    void setPyramidCacheSize(size_t bytes);
+
+protected:
+    /// Copy full resolution pixels of a rectangle, ``stride`` is in pixels
+    virtual bool readRegion(int x, int y, int width, int height,
+                            uint8_t *rgba, size_t stride);
+
+    /* Reduced tile cache, shared by the loader threads */
+    struct CachedTile {
+        uint64_t key;
+        bool valid;
+        std::vector<uint8_t> rgba;
+    };
+    bool cachedTile(uint64_t key, uint8_t *rgba, bool &valid);
+    void cacheTile(uint64_t key, const uint8_t *rgba, bool valid);
+
+    Vector2i mSize;
+    int mTileSize;
+    int mLevelCount;
+
+    std::mutex mPyramidMutex;
+    std::list<CachedTile> mPyramid; /* most recently used first */
+    std::unordered_map<uint64_t, std::list<CachedTile>::iterator> mPyramidIndex;
+    size_t mPyramidCacheSize = 64 * 1024 * 1024;
+};
+
+/// Tile source asking a function for every tile, see \ref TileSource::readTile
+class NANOGUI_EXPORT CallbackTileSource : public TileSource {
+public:
+    using Callback = std::function<bool(int level, int x, int y, uint8_t *rgba)>;
+
+    CallbackTileSource(const Vector2i &size, const Callback &callback, int tileSize = 256)
+        : TileSource(size, tileSize), mCallback(callback) { }
+
+    bool readTile(int level, int x, int y, uint8_t *rgba) override {
+        return mCallback(level, x, y, rgba);
+    }
+
+protected:
+    Callback mCallback;
+};
+
+/**
+ * \class MappedFileTileSource tilesource.h nanogui/tilesource.h
+ *
+ * \brief Raw, uncompressed RGBA8 file mapped into memory.
+ *
+ * Pixels are stored row by row starting at ``offset`` bytes into the file.
+ * Only the pages of the tiles that are displayed are actually read.
+ */
+class NANOGUI_EXPORT MappedFileTileSource : public TileSource {
+public:
+    MappedFileTileSource(const std::string &path, const Vector2i &size,
+                         size_t offset = 0, int tileSize = 256);
+    ~MappedFileTileSource();
+
+protected:
+    bool readRegion(int x, int y, int width, int height,
+                    uint8_t *rgba, size_t stride) override;
+    void unmap();
+
+    const uint8_t *mData = nullptr;
+    size_t mMappedSize = 0;
+    size_t mOffset;
+#if defined(_WIN32)
+    void *mFile = nullptr;
+    void *mMapping = nullptr;
+#endif
+};
+
+NAMESPACE_END(nanogui)
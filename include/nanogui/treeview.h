@@ -1,7 +1,10 @@
 #pragma once
 
 #include <nanogui/treeviewitem.h>
+#include <nanogui/textindex.h>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -60,11 +63,28 @@ public:
 
     void recheckChildren();
 
+    //! Show only the nodes whose caption contains query (case-insensitive),
+    //! together with their ancestors, which are expanded while the filter is
+    //! set. An empty query shows the tree as it was. Captions are kept in a
+    //! trigram index, a query extending the previous one only checks the
+    //! nodes matched so far.
+    void setFilter(const std::string& query);
+    const std::string& filter() const { return mFilter; }
+
+    //! Rebuild the filter index on next use, call it after changing captions
+    void invalidateFilter() { mFilterIndexValid = false; updateItems(); }
+
+    //! Whether node is currently shown, considering the filter
+    bool isNodeShown(const TreeViewItem* node) const;
+
 private:
     void _recalculateItemsRectangle(NVGcontext* ctx);
     void _mouseAction( int xpos, int ypos, bool onlyHover = false );
     Color _getCurrentNodeColor( TreeViewItem* node  );
     std::string _getCurrentNodeFont( TreeViewItem* node );
+    void _applyFilter();
+    void _collectShown(const TreeViewItem* node);
+    const std::vector<TreeViewItem*>& _shownNodes();
 
     std::function<void(TreeViewItem*)> mSelectNodeCallback;
     std::function<void(TreeViewItem*)> mHoverNodeCallback;
@@ -91,6 +111,14 @@ private:
     bool          mNeedUpdateItems;
     float         mScrollBarVscale = 1.f;
     float         mScrollBarHscale = 1.f;
+
+    std::string   mFilter;
+    TextIndex     mFilterIndex;
+    bool          mFilterIndexValid = false;
+    std::vector<TreeViewItem::NodeId> mFilterIds; // node of each index entry
+    std::unordered_map<TreeViewItem::NodeId, TreeViewItem*> mFilterNodes;
+    std::unordered_set<TreeViewItem::NodeId> mFilterShown; // matches and their ancestors
+    std::vector<TreeViewItem*> mShownNodes; // shown nodes in display order
 };
 
 NAMESPACE_END(nanogui)
\ No newline at end of file
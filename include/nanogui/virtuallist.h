@@ -0,0 +1,108 @@
+/*
+    nanogui/virtuallist.h -- Scrollable list drawing only its visible rows
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+/** \file */
+
+#pragma once
+
+#include <nanogui/widget.h>
+
+NAMESPACE_BEGIN(nanogui)
+
+/**
+ * \class VirtualList virtuallist.h nanogui/virtuallist.h
+ *
+ * \brief List of text rows that does not create a widget per item.
+ *
+ * Items are identified by their index and their text is fetched through a
+ * function while drawing, so only the rows that are actually visible are
+ * touched. A subset of the items (e.g. search results) can be shown with
+ * \ref setVisibleItems. The list has its own scroll bar and supports the
+ * usual keyboard navigation.
+ */
+class NANOGUI_EXPORT VirtualList : public Widget {
+public:
+    RTTI_CLASS_UID("VLST")
+    RTTI_DECLARE_INFO(VirtualList)
+
+    /// Returns the text of an item, the reference must stay valid while drawing
+    using ItemText = std::function<const std::string &(int index)>;
+
+    explicit VirtualList(Widget *parent);
+
+    /// Set the number of items and how to get their text, shows all of them
+    void setItems(int count, const ItemText &text);
+
+    /// Number of items
+    int itemCount() const { return mItemCount; }
+
+    /// Only show the given items (in this order)
+    void setVisibleItems(const std::vector<uint32_t> &items);
+
+    /// Show all items again
+    void clearVisibleItems();
+
+    /// Number of rows currently shown
+    int rowCount() const { return mFiltered ? (int) mRows.size() : mItemCount; }
+
+    /// Item shown in ``row``
+    int itemAtRow(int row) const { return mFiltered ? (int) mRows[row] : row; }
+
+    /// Row showing ``index``, or -1 if the item is filtered out
+    int rowOfItem(int index) const;
+
+    /// The selected item, -1 if there is none
+    int selectedIndex() const { return mSelectedIndex; }
+    void setSelectedIndex(int index);
+
+    int rowHeight() const { return mRowHeight; }
+    void setRowHeight(int height) { mRowHeight = std::max(height, 1); }
+
+    /// Number of rows the preferred size makes room for
+    int visibleRowCount() const { return mVisibleRowCount; }
+    void setVisibleRowCount(int count) { mVisibleRowCount = std::max(count, 1); }
+
+    /// Scroll so that ``index`` is visible
+    void scrollToItem(int index);
+
+    /// Called with the item index when a row is clicked or Enter is pressed
+    std::function<void(int)> callback() const { return mCallback; }
+    void setCallback(const std::function<void(int)> &callback) { mCallback = callback; }
+
+    virtual Vector2i preferredSize(NVGcontext *ctx) const override;
+    virtual void draw(NVGcontext *ctx) override;
+    virtual bool mouseButtonEvent(const Vector2i &p, int button, bool down, int modifiers) override;
+    virtual bool mouseMotionEvent(const Vector2i &p, const Vector2i &rel, int button, int modifiers) override;
+    virtual bool mouseDragEvent(const Vector2i &p, const Vector2i &rel, int button, int modifiers) override;
+    virtual bool mouseEnterEvent(const Vector2i &p, bool enter) override;
+    virtual bool scrollEvent(const Vector2i &p, const Vector2f &rel) override;
+    virtual bool keyboardEvent(int key, int scancode, int action, int modifiers) override;
+
+protected:
+    int rowAt(const Vector2i &p) const;
+    int contentHeight() const { return rowCount() * mRowHeight; }
+    void setScroll(float scroll);
+    void activate(int row);
+
+    int mItemCount = 0;
+    ItemText mItemText;
+    std::vector<uint32_t> mRows;
+    bool mFiltered = false;
+    int mSelectedIndex = -1;
+    int mHoverRow = -1;
+    int mRowHeight = 24;
+    int mVisibleRowCount = 10;
+    /// Scroll offset in pixels
+    float mScroll = 0.f;
+    bool mDraggingScrollbar = false;
+    std::function<void(int)> mCallback;
+};
+
+NAMESPACE_END(nanogui)
@@ -155,6 +155,15 @@ public:
       return Vector4i(p.x(), p.y(), p.x() + width(), p.y() + height());
     }
 
+    /**
+     * \brief Part of \ref rect() that is not clipped away by an ancestor.
+     *
+     * Widgets are clipped to the bounds of their parents when drawn, so
+     * contents outside of this rectangle (e.g. rows scrolled out of a
+     * VScrollPanel) can be skipped. Empty rectangles have ``x == z``.
+     */
+    Vector4i visibleRect() const;
+
     Widget *findWidget(const std::string& id, bool inchildren = true);
     Widget *findWidget(std::function<bool(Widget*)> cond, bool inchildren = true);
 
@@ -206,6 +215,11 @@ public:
     void forEachChild(const std::function<void (Widget*)>& f)
     { for (Widget* w : mChildren) f(w); }
 
+    /// Call f for each visible child. Containers holding many hidden
+    /// children, like the cells of a \ref Table, override it to skip them.
+    virtual void forEachVisibleChild(const std::function<void (Widget*)>& f)
+    { for (Widget* w : mChildren) if (w->visible()) f(w); }
+
     /// Return the size of the widget
     const Vector2i &size() const { return mSize; }
     /// set the size of the widget
@@ -362,6 +376,8 @@ public:
     void setFocused(bool focused) { mFocused = focused; }
     /// Request the focus to be moved to this widget
     void requestFocus();
+    /// Ask the parent screen for another frame after ``delay`` seconds (see \ref Screen::requestAnimationFrame)
+    void requestAnimationFrame(double delay = 0.0);
 
     const std::string &tooltip() const { return mTooltip; }
     void setTooltip(const std::string &tooltip) { mTooltip = tooltip; }
@@ -76,7 +76,10 @@ void register_basics(py::module &m) {
         .def("setItems", (void(ComboBox::*)(const std::vector<std::string>&,
                           const std::vector<std::string>&)) &ComboBox::setItems/*, D(ComboBox, setItems, 2)*/)
         .def("items", &ComboBox::items, D(ComboBox, items))
-        .def("itemsShort", &ComboBox::itemsShort, D(ComboBox, itemsShort));
+        .def("itemsShort", &ComboBox::itemsShort, D(ComboBox, itemsShort))
+        .def("setFilter", &ComboBox::setFilter, D(ComboBox, setFilter))
+        .def("searchThreshold", &ComboBox::searchThreshold, D(ComboBox, searchThreshold))
+        .def("setSearchThreshold", &ComboBox::setSearchThreshold, D(ComboBox, setSearchThreshold));
 
     py::class_<ProgressBar, Widget, ref<ProgressBar>, PyProgressBar>(m, "ProgressBar", D(ProgressBar))
         .def(py::init<Widget *>(), py::arg("parent"), D(ProgressBar, ProgressBar))
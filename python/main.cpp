@@ -215,6 +215,9 @@ PYBIND11_MODULE(nanogui, m) {
     #endif
     m.def("utf8", [](int c) { return std::string(utf8(c).data()); }, D(utf8));
     m.def("loadImageDirectory", &nanogui::loadImageDirectory, D(loadImageDirectory));
+    m.def("loadImageDirectoryAsync", &nanogui::loadImageDirectoryAsync,
+          py::arg("ctx"), py::arg("path"), py::arg("callback") = nullptr,
+          py::arg("filter") = nullptr, D(loadImageDirectoryAsync));
 
     py::enum_<Cursor>(m, "Cursor", D(Cursor))
         .value("Arrow", Cursor::Arrow)
@@ -1,12 +1,56 @@
 #ifdef NANOGUI_PYTHON
 
 #include "python.h"
+#include <nanogui/ledmatrix.h>
+#include <pybind11/numpy.h>
 
 DECLARE_WIDGET(ColorWheel);
 DECLARE_WIDGET(ColorPicker);
 DECLARE_WIDGET(Graph);
 DECLARE_WIDGET(ImageView);
 DECLARE_WIDGET(ImagePanel);
+DECLARE_WIDGET(LedMatrix);
+
+/* Bulk setters accept NumPy arrays and any other buffer-protocol object.
+   Arrays of the right dtype and layout are read in place, anything else is
+   converted once by pybind11 (forcecast). The GIL is released while the
+   data is copied into the widget */
+using FloatArray = py::array_t<float, py::array::c_style | py::array::forcecast>;
+using UInt8Array = py::array_t<uint8_t, py::array::c_style | py::array::forcecast>;
+using UInt32Array = py::array_t<uint32_t, py::array::c_style | py::array::forcecast>;
+
+static void graphSetValues(Graph &graph, FloatArray values) {
+    if (values.ndim() != 1)
+        throw py::type_error("Graph.setValues(): expects a 1D array");
+    const float *data = values.data();
+    size_t size = (size_t) values.shape(0);
+    py::gil_scoped_release release;
+    graph.values().assign(data, data + size);
+}
+
+/* Writable view onto the values owned by the graph, valid until their count changes */
+static py::array graphValuesView(py::object self) {
+    VectorXf &values = self.cast<Graph &>().values();
+    return py::array_t<float>({ values.size() }, { sizeof(float) }, values.data(), self);
+}
+
+static void ledMatrixSetColors(LedMatrix &matrix, UInt32Array colors) {
+    if (colors.ndim() != 2)
+        throw py::type_error("LedMatrix.setColors(): expects a 2D array (rows x columns)");
+    const uint32_t *data = colors.data();
+    int rows = (int) colors.shape(0), columns = (int) colors.shape(1);
+    py::gil_scoped_release release;
+    matrix.setColors(data, rows, columns, (size_t) columns);
+}
+
+static void imageViewSetImageData(ImageView &view, UInt8Array pixels) {
+    if (pixels.ndim() != 3 || pixels.shape(2) != 4)
+        throw py::type_error("ImageView.setImageData(): expects an RGBA array (height x width x 4)");
+    const uint8_t *data = pixels.data();
+    int height = (int) pixels.shape(0), width = (int) pixels.shape(1);
+    py::gil_scoped_release release;
+    view.setImageData(width, height, data);
+}
 
 void register_misc(py::module &m) {
     py::class_<ColorWheel, Widget, ref<ColorWheel>, PyColorWheel>(m, "ColorWheel", D(ColorWheel))
@@ -43,11 +87,21 @@ void register_misc(py::module &m) {
         .def("textColor", &Graph::textColor, D(Graph, textColor))
         .def("setTextColor", &Graph::setTextColor, D(Graph, setTextColor))
         .def("values", (VectorXf &(Graph::*)(void)) &Graph::values, D(Graph, values))
-        .def("setValues", &Graph::setValues, D(Graph, setValues));
+        .def("setValues", &graphSetValues, py::arg("values"), D(Graph, setValues))
+        .def("valuesView", &graphValuesView, D(Graph, valuesView));
+
+    py::class_<ImageView::PixelInfoRegion>(m, "PixelInfoRegion", D(ImageView, PixelInfoRegion))
+        .def_readwrite("origin", &ImageView::PixelInfoRegion::origin, D(ImageView, PixelInfoRegion, origin))
+        .def_readwrite("size", &ImageView::PixelInfoRegion::size, D(ImageView, PixelInfoRegion, size))
+        .def_readwrite("channels", &ImageView::PixelInfoRegion::channels, D(ImageView, PixelInfoRegion, channels))
+        .def_readwrite("precision", &ImageView::PixelInfoRegion::precision, D(ImageView, PixelInfoRegion, precision))
+        .def_readwrite("values", &ImageView::PixelInfoRegion::values, D(ImageView, PixelInfoRegion, values))
+        .def_readwrite("colors", &ImageView::PixelInfoRegion::colors, D(ImageView, PixelInfoRegion, colors));
 
     py::class_<ImageView, Widget, ref<ImageView>, PyImageView>(m, "ImageView", D(ImageView))
         .def(py::init<Widget *, uint32_t>(), D(ImageView, ImageView))
         .def("bindImage", &ImageView::bindImage, D(ImageView, bindImage))
+        .def("setImageData", &imageViewSetImageData, py::arg("pixels"), D(ImageView, setImageData))
         //.def("imageShader", &ImageView::imageShader, D(ImageView, imageShader))
         .def("scaledImageSize", &ImageView::scaledImageSize, D(ImageView, scaledImageSize))
         .def("offset", &ImageView::offset, D(ImageView, offset))
@@ -65,6 +119,9 @@ void register_misc(py::module &m) {
         .def("setPixelInfoThreshold", &ImageView::setPixelInfoThreshold, D(ImageView, setPixelInfoThreshold))
         .def("setPixelInfoCallback", &ImageView::setPixelInfoCallback, D(ImageView, setPixelInfoCallback))
         .def("pixelInfoCallback", &ImageView::pixelInfoCallback, D(ImageView, pixelInfoCallback))
+        .def("setPixelInfoRegionCallback", &ImageView::setPixelInfoRegionCallback, D(ImageView, setPixelInfoRegionCallback))
+        .def("pixelInfoRegionCallback", &ImageView::pixelInfoRegionCallback, D(ImageView, pixelInfoRegionCallback))
+        .def("invalidatePixelInfo", &ImageView::invalidatePixelInfo, D(ImageView, invalidatePixelInfo))
         .def("setFontScaleFactor", &ImageView::setFontScaleFactor, D(ImageView, setFontScaleFactor))
         .def("fontScaleFactor", &ImageView::fontScaleFactor, D(ImageView, fontScaleFactor))
         .def("imageCoordinateAt", &ImageView::imageCoordinateAt, D(ImageView, imageCoordinateAt))
@@ -85,7 +142,21 @@ void register_misc(py::module &m) {
         .def("images", &ImagePanel::images, D(ImagePanel, images))
         .def("setImages", &ImagePanel::setImages, D(ImagePanel, setImages))
         .def("callback", &ImagePanel::callback, D(ImagePanel, callback))
-        .def("setCallback", &ImagePanel::setCallback, D(ImagePanel, setCallback));
+        .def("setCallback", &ImagePanel::setCallback, D(ImagePanel, setCallback))
+        .def("useAtlas", &ImagePanel::useAtlas, D(ImagePanel, useAtlas))
+        .def("setUseAtlas", &ImagePanel::setUseAtlas, D(ImagePanel, setUseAtlas))
+        .def("maxAtlasPages", &ImagePanel::maxAtlasPages, D(ImagePanel, maxAtlasPages))
+        .def("setMaxAtlasPages", &ImagePanel::setMaxAtlasPages, D(ImagePanel, setMaxAtlasPages));
+
+    py::class_<LedMatrix, Widget, ref<LedMatrix>, PyLedMatrix>(m, "LedMatrix", D(LedMatrix))
+        .def(py::init<Widget *>(), py::arg("parent"), D(LedMatrix, LedMatrix))
+        .def("clear", &LedMatrix::clear, D(LedMatrix, clear))
+        .def("rowCount", &LedMatrix::rowCount, D(LedMatrix, rowCount))
+        .def("setRowCount", &LedMatrix::setRowCount, D(LedMatrix, setRowCount))
+        .def("columnCount", &LedMatrix::columnCount, D(LedMatrix, columnCount))
+        .def("colorAt", &LedMatrix::colorAt, D(LedMatrix, colorAt))
+        .def("setColorAt", &LedMatrix::setColorAt, D(LedMatrix, setColorAt))
+        .def("setColors", &ledMatrixSetColors, py::arg("colors"), D(LedMatrix, setColors));
 }
 
 #endif
@@ -1064,16 +1064,24 @@ static const char *__doc_nanogui_ComboBox_save = R"doc(Saves the state of this C
 
 static const char *__doc_nanogui_ComboBox_scrollEvent = R"doc(Handles mouse scrolling events for this ComboBox.)doc";
 
+static const char *__doc_nanogui_ComboBox_searchThreshold = R"doc(Number of items from which the popup shows a search field)doc";
+
 static const char *__doc_nanogui_ComboBox_selectedIndex = R"doc(The current index this ComboBox has selected.)doc";
 
 static const char *__doc_nanogui_ComboBox_setCallback = R"doc(Sets the callback to execute for this ComboBox.)doc";
 
+static const char *__doc_nanogui_ComboBox_setFilter =
+R"doc(Only list the items containing ``text`` (case insensitive), an empty
+string shows all)doc";
+
 static const char *__doc_nanogui_ComboBox_setItems =
 R"doc(Sets the items for this ComboBox, providing both short and long
 descriptive lables for each item.)doc";
 
 static const char *__doc_nanogui_ComboBox_setItems_2 = R"doc(Sets the items for this ComboBox.)doc";
 
+static const char *__doc_nanogui_ComboBox_setSearchThreshold = R"doc()doc";
+
 static const char *__doc_nanogui_ComboBox_setSelectedIndex = R"doc(Sets the current index this ComboBox has selected.)doc";
 
 static const char *__doc_nanogui_Cursor =
@@ -1713,6 +1721,10 @@ static const char *__doc_nanogui_Graph_textColor = R"doc()doc";
 
 static const char *__doc_nanogui_Graph_values = R"doc()doc";
 
+static const char *__doc_nanogui_Graph_valuesView =
+R"doc(Writable NumPy view onto the values owned by the graph. The view is
+valid until the number of values changes.)doc";
+
 static const char *__doc_nanogui_Graph_values_2 = R"doc()doc";
 
 static const char *__doc_nanogui_GridLayout =
@@ -1909,6 +1921,10 @@ static const char *__doc_nanogui_ImagePanel_mSpacing = R"doc()doc";
 
 static const char *__doc_nanogui_ImagePanel_mThumbSize = R"doc()doc";
 
+static const char *__doc_nanogui_ImagePanel_maxAtlasPages =
+R"doc(Number of atlas pages kept on the GPU, the least recently drawn page is
+reused first)doc";
+
 static const char *__doc_nanogui_ImagePanel_mouseButtonEvent = R"doc()doc";
 
 static const char *__doc_nanogui_ImagePanel_mouseMotionEvent = R"doc()doc";
@@ -1943,10 +1959,39 @@ static const char *__doc_nanogui_ImagePanel_setCallback = R"doc()doc";
 
 static const char *__doc_nanogui_ImagePanel_setImages = R"doc()doc";
 
+static const char *__doc_nanogui_ImagePanel_setMaxAtlasPages = R"doc()doc";
+
+static const char *__doc_nanogui_ImagePanel_setUseAtlas = R"doc()doc";
+
+static const char *__doc_nanogui_ImagePanel_useAtlas =
+R"doc(Whether thumbnails are drawn from shared atlas pages, off by default.
+Textures can't be read back, so each image is decoded again from its
+path and downscaled in the background (see AsyncImageLoader); images
+without a loadable path are drawn individually from their texture.
+Only the thumbnails of pages kept on the GPU stay in memory.)doc";
+
 static const char *__doc_nanogui_ImageView = R"doc(Widget used to display images.)doc";
 
 static const char *__doc_nanogui_ImageView_ImageView = R"doc()doc";
 
+static const char *__doc_nanogui_ImageView_PixelInfoRegion =
+R"doc(Values of a rectangle of pixels shown by the pixel info overlay.
+
+The view sets origin and size and sizes the buffers before passing the
+region to the callback, which fills them in.)doc";
+
+static const char *__doc_nanogui_ImageView_PixelInfoRegion_channels = R"doc(Number of values shown per pixel, one per line (at most 4))doc";
+
+static const char *__doc_nanogui_ImageView_PixelInfoRegion_colors = R"doc(Text color of each pixel)doc";
+
+static const char *__doc_nanogui_ImageView_PixelInfoRegion_origin = R"doc(First pixel of the rectangle)doc";
+
+static const char *__doc_nanogui_ImageView_PixelInfoRegion_precision = R"doc(Digits after the decimal point)doc";
+
+static const char *__doc_nanogui_ImageView_PixelInfoRegion_size = R"doc(Number of pixels in each direction)doc";
+
+static const char *__doc_nanogui_ImageView_PixelInfoRegion_values = R"doc(Four values per pixel, row by row; NaN values are not shown)doc";
+
 static const char *__doc_nanogui_ImageView_bindImage = R"doc()doc";
 
 static const char *__doc_nanogui_ImageView_center = R"doc(Centers the image without affecting the scaling factor.)doc";
@@ -1993,6 +2038,8 @@ static const char *__doc_nanogui_ImageView_imageSize = R"doc()doc";
 
 static const char *__doc_nanogui_ImageView_imageSizeF = R"doc()doc";
 
+static const char *__doc_nanogui_ImageView_invalidatePixelInfo = R"doc(Query the pixel info again on the next frame, e.g. after the pixels changed)doc";
+
 static const char *__doc_nanogui_ImageView_keyboardCharacterEvent = R"doc()doc";
 
 static const char *__doc_nanogui_ImageView_keyboardEvent = R"doc()doc";
@@ -2055,6 +2102,8 @@ static const char *__doc_nanogui_ImageView_performLayout = R"doc()doc";
 
 static const char *__doc_nanogui_ImageView_pixelInfoCallback = R"doc()doc";
 
+static const char *__doc_nanogui_ImageView_pixelInfoRegionCallback = R"doc()doc";
+
 static const char *__doc_nanogui_ImageView_pixelInfoThreshold = R"doc()doc";
 
 static const char *__doc_nanogui_ImageView_pixelInfoVisible =
@@ -2091,10 +2140,21 @@ pixel at the provided position on the widget has the specified image
 coordinate. Also clamps the values of offset to the sides of the
 widget.)doc";
 
+static const char *__doc_nanogui_ImageView_setImageData =
+R"doc(Display tightly packed RGBA8 pixels owned by this view. Later calls
+with the same size update the image in place.)doc";
+
 static const char *__doc_nanogui_ImageView_setOffset = R"doc()doc";
 
 static const char *__doc_nanogui_ImageView_setPixelInfoCallback = R"doc()doc";
 
+static const char *__doc_nanogui_ImageView_setPixelInfoRegionCallback =
+R"doc(Provide the pixel info overlay one rectangle at a time.
+
+The callback is invoked once for all visible pixels, and only again
+when the visible pixels or the image change, or after
+invalidatePixelInfo. Takes precedence over the per pixel callback.)doc";
+
 static const char *__doc_nanogui_ImageView_setPixelInfoThreshold = R"doc()doc";
 
 static const char *__doc_nanogui_ImageView_setScale = R"doc()doc";
@@ -2107,7 +2167,7 @@ static const char *__doc_nanogui_ImageView_sizeF = R"doc()doc";
 
 static const char *__doc_nanogui_ImageView_updateImageParameters = R"doc()doc";
 
-static const char *__doc_nanogui_ImageView_writePixelInfo = R"doc()doc";
+static const char *__doc_nanogui_ImageView_updatePixelInfo = R"doc()doc";
 
 static const char *__doc_nanogui_ImageView_zoom =
 R"doc(Changes the scale factor by the provided amount modified by the zoom
@@ -2263,6 +2323,25 @@ Returns:
     The preferred size, accounting for things such as spacing, padding
     for icons, etc.)doc";
 
+static const char *__doc_nanogui_LedMatrix = R"doc(Matrix of LEDs that can show text, images and arbitrary colors.)doc";
+
+static const char *__doc_nanogui_LedMatrix_LedMatrix = R"doc()doc";
+
+static const char *__doc_nanogui_LedMatrix_clear = R"doc()doc";
+
+static const char *__doc_nanogui_LedMatrix_colorAt = R"doc()doc";
+
+static const char *__doc_nanogui_LedMatrix_columnCount = R"doc()doc";
+
+static const char *__doc_nanogui_LedMatrix_rowCount = R"doc()doc";
+
+static const char *__doc_nanogui_LedMatrix_setColorAt = R"doc()doc";
+
+static const char *__doc_nanogui_LedMatrix_setColors =
+R"doc(Set all LEDs at once from row-major ``0xRRGGBBAA`` values.)doc";
+
+static const char *__doc_nanogui_LedMatrix_setRowCount = R"doc()doc";
+
 static const char *__doc_nanogui_MessageDialog = R"doc(Simple "OK" or "Yes/No"-style modal dialogs.)doc";
 
 static const char *__doc_nanogui_MessageDialog_MessageDialog = R"doc()doc";
@@ -2696,6 +2775,14 @@ static const char *__doc_nanogui_Screen_pixelRatio =
 R"doc(Return the ratio between pixel and device coordinates (e.g. >= 2 on
 Mac Retina displays))doc";
 
+static const char *__doc_nanogui_Screen_post =
+R"doc(Run ``command`` on the main thread at the start of the next frame. May
+be called from any thread.)doc";
+
+static const char *__doc_nanogui_Screen_post_2 =
+R"doc(Queue a command that replaces a still pending one with the same key.
+Only the most recent command per key and frame runs.)doc";
+
 static const char *__doc_nanogui_Screen_resizeCallback = R"doc(Set the resize callback)doc";
 
 static const char *__doc_nanogui_Screen_resizeCallbackEvent = R"doc()doc";
@@ -2800,10 +2887,26 @@ static const char *__doc_nanogui_StackedWidget = R"doc(A stack widget.)doc";
 
 static const char *__doc_nanogui_StackedWidget_StackedWidget = R"doc()doc";
 
+static const char *__doc_nanogui_StackedWidget_addLazyPage =
+R"doc(Add a page whose contents are created when it is first shown.
+
+Returns the page widget, which stays empty until ``factory`` is called
+on it. Until then ``sizeHint`` stands in for its preferred size.)doc";
+
 static const char *__doc_nanogui_StackedWidget_addChild = R"doc()doc";
 
+static const char *__doc_nanogui_StackedWidget_isPageBuilt = R"doc(Whether the contents of page ``index`` currently exist)doc";
+
 static const char *__doc_nanogui_StackedWidget_mSelectedIndex = R"doc()doc";
 
+static const char *__doc_nanogui_StackedWidget_maxLoadedPages =
+R"doc(Maximum number of lazy pages whose contents are kept.
+
+When more are built, the contents of the least recently shown ones are
+removed and recreated by their factory the next time they are shown.
+Pointers into an unloaded page become invalid. 0 (the default) never
+unloads anything.)doc";
+
 static const char *__doc_nanogui_StackedWidget_operator_delete = R"doc()doc";
 
 static const char *__doc_nanogui_StackedWidget_operator_delete_2 = R"doc()doc";
@@ -2834,6 +2937,8 @@ static const char *__doc_nanogui_StackedWidget_preferredSize = R"doc()doc";
 
 static const char *__doc_nanogui_StackedWidget_selectedIndex = R"doc()doc";
 
+static const char *__doc_nanogui_StackedWidget_setMaxLoadedPages = R"doc()doc";
+
 static const char *__doc_nanogui_StackedWidget_setSelectedIndex = R"doc()doc";
 
 static const char *__doc_nanogui_TabHeader = R"doc(A Tab navigable widget.)doc";
@@ -3030,6 +3135,12 @@ associates it with the provided widget.)doc";
 
 static const char *__doc_nanogui_TabWidget_callback = R"doc()doc";
 
+static const char *__doc_nanogui_TabWidget_createLazyTab =
+R"doc(Creates a tab whose contents are built by ``factory`` when the tab is
+first activated. See StackedWidget::addLazyPage.)doc";
+
+static const char *__doc_nanogui_TabWidget_createLazyTab_2 = R"doc()doc";
+
 static const char *__doc_nanogui_TabWidget_createTab =
 R"doc(Creates a new tab with the specified name and returns a pointer to the
 layer.)doc";
@@ -3052,6 +3163,10 @@ static const char *__doc_nanogui_TabWidget_mContent = R"doc()doc";
 
 static const char *__doc_nanogui_TabWidget_mHeader = R"doc()doc";
 
+static const char *__doc_nanogui_TabWidget_maxLoadedTabs =
+R"doc(Maximum number of lazy tabs whose contents are kept, see
+StackedWidget::setMaxLoadedPages)doc";
+
 static const char *__doc_nanogui_TabWidget_operator_delete = R"doc()doc";
 
 static const char *__doc_nanogui_TabWidget_operator_delete_2 = R"doc()doc";
@@ -3086,6 +3201,8 @@ label. Returns whether the removal was successful.)doc";
 
 static const char *__doc_nanogui_TabWidget_removeTab_2 = R"doc(Removes the tab with the specified index.)doc";
 
+static const char *__doc_nanogui_TabWidget_setMaxLoadedTabs = R"doc()doc";
+
 static const char *__doc_nanogui_TabWidget_setActiveTab = R"doc()doc";
 
 static const char *__doc_nanogui_TabWidget_setCallback =
@@ -3514,6 +3631,13 @@ static const char *__doc_nanogui_Theme_operator_new_4 = R"doc()doc";
 
 static const char *__doc_nanogui_Theme_operator_new_5 = R"doc()doc";
 
+static const char *__doc_nanogui_Theme_touch = R"doc(Increment the version after assigning members directly)doc";
+
+static const char *__doc_nanogui_Theme_version =
+R"doc(Counter incremented on every change made through the property
+interface. Widgets can keep values derived from the theme until the
+version changes.)doc";
+
 static const char *__doc_nanogui_ToolButton = R"doc(Simple radio+toggle button with an icon.)doc";
 
 static const char *__doc_nanogui_ToolButton_ToolButton = R"doc()doc";
@@ -4200,6 +4324,12 @@ static const char *__doc_nanogui_loadImageDirectory =
 R"doc(Load a directory of PNG images and upload them to the GPU (suitable
 for use with ImagePanel))doc";
 
+static const char *__doc_nanogui_loadImageDirectoryAsync =
+R"doc(Asynchronous variant of loadImageDirectory. Returns the matching files
+right away, each paired with a placeholder image. The images are
+decoded in the background, ``callback`` is invoked for every file once
+its image is uploaded.)doc";
+
 static const char *__doc_nanogui_lookAt =
 R"doc(Creates a "look at" matrix that describes the position and orientation
 of e.g. a camera
@@ -4397,6 +4527,13 @@ components with the corresponding entries of the 3D vector ``v``. The
 Parameter ``v``:
     The vector representing the scaling for each axis.)doc";
 
+static const char *__doc_nanogui_setMany =
+R"doc(Set ``attr`` on many widgets in one call. ``values`` is either a
+sequence with one value per widget or a single value applied to all of
+them. Supported attributes: ``caption``, ``value``, ``tooltip``,
+``visible``, ``enabled`` and ``fontSize``. The values are applied with
+the GIL released and layout is requested once per affected parent.)doc";
+
 static const char *__doc_nanogui_shutdown = R"doc(Static shutdown; should be called before the application terminates.)doc";
 
 static const char *__doc_nanogui_translate =
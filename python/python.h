@@ -3,6 +3,7 @@
 
 #include <nanogui/nanogui.h>
 #include <nanogui/opengl.h>
+#include <nanogui/imageloader.h>
 
 #include <pybind11/stl.h>
 #include <pybind11/operators.h>
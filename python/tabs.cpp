@@ -10,7 +10,12 @@ void register_tabs(py::module &m) {
     py::class_<StackedWidget, Widget, ref<StackedWidget>, PyStackedWidget>(m, "StackedWidget", D(StackedWidget))
         .def(py::init<Widget *>(), D(StackedWidget, StackedWidget))
         .def("selectedIndex", &StackedWidget::selectedIndex, D(StackedWidget, selectedIndex))
-        .def("setSelectedIndex", &StackedWidget::setSelectedIndex, D(StackedWidget, setSelectedIndex));
+        .def("setSelectedIndex", &StackedWidget::setSelectedIndex, D(StackedWidget, setSelectedIndex))
+        .def("addLazyPage", (Widget *(StackedWidget::*)(int, const StackedWidget::PageFactory &, const Vector2i &)) &StackedWidget::addLazyPage,
+             py::arg("index"), py::arg("factory"), py::arg("sizeHint") = Vector2i::Zero(), D(StackedWidget, addLazyPage))
+        .def("isPageBuilt", &StackedWidget::isPageBuilt, D(StackedWidget, isPageBuilt))
+        .def("maxLoadedPages", &StackedWidget::maxLoadedPages, D(StackedWidget, maxLoadedPages))
+        .def("setMaxLoadedPages", &StackedWidget::setMaxLoadedPages, D(StackedWidget, setMaxLoadedPages));
 
     py::class_<TabHeader, Widget, ref<TabHeader>, PyTabHeader>(m, "TabHeader", D(TabHeader))
         .def(py::init<Widget *, const std::string &>(), D(TabHeader, TabHeader))
@@ -40,6 +45,12 @@ void register_tabs(py::module &m) {
         .def("addTab", (void (TabWidget::*)(int index, const std::string &, Widget *)) &TabWidget::addTab, D(TabWidget, addTab, 2))
         .def("createTab", (Widget *(TabWidget::*)(const std::string &)) &TabWidget::createTab, D(TabWidget, createTab))
         .def("createTab", (Widget *(TabWidget::*)(int index, const std::string &)) &TabWidget::createTab, D(TabWidget, createTab, 2))
+        .def("createLazyTab", (Widget *(TabWidget::*)(const std::string &, const StackedWidget::PageFactory &, const Vector2i &)) &TabWidget::createLazyTab,
+             py::arg("label"), py::arg("factory"), py::arg("sizeHint") = Vector2i::Zero(), D(TabWidget, createLazyTab))
+        .def("createLazyTab", (Widget *(TabWidget::*)(int, const std::string &, const StackedWidget::PageFactory &, const Vector2i &)) &TabWidget::createLazyTab,
+             py::arg("index"), py::arg("label"), py::arg("factory"), py::arg("sizeHint") = Vector2i::Zero(), D(TabWidget, createLazyTab, 2))
+        .def("maxLoadedTabs", &TabWidget::maxLoadedTabs, D(TabWidget, maxLoadedTabs))
+        .def("setMaxLoadedTabs", &TabWidget::setMaxLoadedTabs, D(TabWidget, setMaxLoadedTabs))
         .def("removeTab", (bool (TabWidget::*)(const std::string &)) &TabWidget::removeTab, D(TabWidget, removeTab))
         .def("removeTab", (void (TabWidget::*)(int index)) &TabWidget::removeTab, D(TabWidget, removeTab, 2))
         .def("tabLabelAt", &TabWidget::tabLabelAt, D(TabWidget, tabLabelAt))
@@ -1,12 +1,105 @@
 #ifdef NANOGUI_PYTHON
 
 #include "python.h"
+#include <set>
 
 DECLARE_WIDGET(Widget);
 DECLARE_SCREEN(Screen);
 DECLARE_WIDGET(Window);
 
+/* setMany(): converts all values under the GIL, then applies them with the
+   GIL released. Size-affecting changes queue one layout per distinct
+   parent, and every touched screen is redrawn once */
+template <typename T, typename Setter>
+static void setManyImpl(const std::vector<Widget *> &widgets, py::handle values,
+                        const std::string &attr, bool affectsLayout, Setter setter) {
+    std::vector<T> converted;
+    bool broadcast = !py::isinstance<py::sequence>(values) || py::isinstance<py::str>(values);
+    if (broadcast) {
+        converted.assign(1, values.cast<T>());
+    } else {
+        auto seq = py::reinterpret_borrow<py::sequence>(values);
+        if (seq.size() != widgets.size())
+            throw py::value_error("setMany(): got " + std::to_string(seq.size()) +
+                                  " values for " + std::to_string(widgets.size()) + " widgets");
+        converted.reserve(seq.size());
+        for (auto v : seq)
+            converted.push_back(v.cast<T>());
+    }
+
+    size_t unsupported = widgets.size();
+    {
+        py::gil_scoped_release release;
+        std::set<Widget *> parents;
+        std::set<Screen *> screens;
+        for (size_t i = 0; i < widgets.size(); ++i) {
+            Widget *w = widgets[i];
+            if (!setter(w, converted[broadcast ? 0 : i])) {
+                unsupported = i;
+                break;
+            }
+            if (affectsLayout && w->parent())
+                parents.insert(w->parent());
+            if (Screen *scr = w->screen())
+                screens.insert(scr);
+        }
+        for (auto p : parents) {
+            if (Screen *scr = p->screen())
+                scr->needPerformLayout(p);
+        }
+        for (auto scr : screens)
+            scr->requestRedraw();
+    }
+    if (unsupported != widgets.size())
+        throw py::type_error("setMany(): widget " + std::to_string(unsupported) +
+                             " has no attribute \"" + attr + "\"");
+}
+
+static void setMany(const std::vector<Widget *> &widgets, const std::string &attr, py::object values) {
+    if (attr == "caption") {
+        setManyImpl<std::string>(widgets, values, attr, true, [](Widget *w, const std::string &v) {
+            if (auto label = w->cast<Label>()) label->setCaption(v);
+            else if (auto button = w->cast<Button>()) button->setCaption(v);
+            else if (auto checkbox = w->cast<CheckBox>()) checkbox->setCaption(v);
+            else if (auto window = w->cast<Window>()) window->setTitle(v);
+            else return false;
+            return true;
+        });
+    } else if (attr == "value") {
+        setManyImpl<float>(widgets, values, attr, false, [](Widget *w, float v) {
+            if (auto bar = w->cast<ProgressBar>()) bar->setValue(v);
+            else if (auto slider = w->cast<Slider>()) slider->setValue(v);
+            else return false;
+            return true;
+        });
+    } else if (attr == "tooltip") {
+        setManyImpl<std::string>(widgets, values, attr, false, [](Widget *w, const std::string &v) {
+            w->setTooltip(v);
+            return true;
+        });
+    } else if (attr == "visible") {
+        setManyImpl<bool>(widgets, values, attr, false, [](Widget *w, bool v) {
+            w->setVisible(v); /* queues its own layout */
+            return true;
+        });
+    } else if (attr == "enabled") {
+        setManyImpl<bool>(widgets, values, attr, false, [](Widget *w, bool v) {
+            w->setEnabled(v);
+            return true;
+        });
+    } else if (attr == "fontSize") {
+        setManyImpl<int>(widgets, values, attr, true, [](Widget *w, int v) {
+            w->setFontSize(v);
+            return true;
+        });
+    } else {
+        throw py::value_error("setMany(): unsupported attribute \"" + attr + "\"");
+    }
+}
+
 void register_widget(py::module &m) {
+    m.def("setMany", &setMany, py::arg("widgets"), py::arg("attr"), py::arg("values"), D(setMany));
+
     py::class_<Widget, ref<Widget>, PyWidget>(m, "Widget", D(Widget))
         .def(py::init<Widget *>(), D(Widget, Widget))
         .def("parent", (Widget *(Widget::*)(void)) &Widget::parent, D(Widget, parent))
@@ -119,6 +212,19 @@ void register_widget(py::module &m) {
         .def("resizeCallback", &Screen::resizeCallback)
         .def("setResizeCallback", &Screen::setResizeCallback)
         .def("dropEvent", &Screen::dropEvent, D(Screen, dropEvent))
+        .def("post", [](Screen &screen, const std::function<void()> &command) {
+                screen.post(command);
+            }, py::arg("command"), D(Screen, post))
+        .def("post", [](Screen &screen, py::object key, const std::function<void()> &command) {
+                /* The command keeps the key alive until it ran or was replaced,
+                   so its address cannot be reused by another key meanwhile.
+                   Commands are dropped by the main loop, without the GIL */
+                std::shared_ptr<py::object> keep(new py::object(key), [](py::object *o) {
+                    py::gil_scoped_acquire acquire;
+                    delete o;
+                });
+                screen.post(key.ptr(), [keep, command]() { command(); });
+            }, py::arg("key"), py::arg("command"), D(Screen, post, 2))
         .def("mousePos", &Screen::mousePos, D(Screen, mousePos))
         .def("pixelRatio", &Screen::pixelRatio, D(Screen, pixelRatio))
         .def("nvgContext", &Screen::nvgContext, D(Screen, nvgContext),
@@ -13,6 +13,10 @@
 
 #include <nanogui/screen.h>
 #include <nanogui/theme.h>
+#include <nanogui/textcache.h>
+#include <nanogui/imageloader.h>
+#include <nanogui/imagecache.h>
+#include <nanogui/fontregistry.h>
 #include <nanogui/window.h>
 #include <nanogui/popup.h>
 #include <nanovg.h>
@@ -30,6 +34,10 @@ void appForEachScreen(std::function<void(Screen*)> f)
 
 Screen::~Screen() {
     __nanogui_screens.erase(mHwWindow);
+    AsyncImageLoader::release(mNVGContext);
+    ImageCache::release(mNVGContext);
+    TextLayoutCache::release(mNVGContext);
+    FontRegistry::release(mNVGContext);
 }
 
 intptr_t Screen::createStandardCursor(int) { return 0; }
@@ -61,6 +69,7 @@ bool appIsShouldCloseScreen(Screen* screen) { return false; }
 void Screen::setVisible(bool visible) { Widget::setVisible(visible); }
 bool appPostEmptyEvent() { return false; }
 bool appWaitEvents(void) { return false; }
+bool appWaitEventsTimeout(double) { return false; }
 bool appPollEvents() { return false; }
 void Screen::_internalSetCursor(int) {}
 void Screen::setClipboardString(const std::string & text) {}
@@ -11,6 +11,7 @@
 
 #include <nanogui/button.h>
 #include <nanogui/theme.h>
+#include <nanogui/textcache.h>
 #include <nanovg.h>
 #include <nanogui/common.h>
 #include <nanogui/serializer/json.h>
@@ -32,17 +33,14 @@ Button::Button(Widget *parent, const std::string &caption, int icon)
 
 Vector2i Button::preferredSize(NVGcontext *ctx) const {
     int fontSize = mFontSize == -1 ? mTheme->mButtonFontSize : mFontSize;
-    nvgFontSize(ctx, (float)fontSize);
-    nvgFontFace(ctx, "sans-bold");
-    float tw = nvgTextBounds(ctx, 0,0, mCaption.c_str(), nullptr, nullptr);
+    auto &cache = TextLayoutCache::get(ctx);
+    float tw = cache.measure(mTheme->mFontBold, (float)fontSize, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, mCaption).advance;
     float iw = 0.0f, ih = (float)fontSize;
 
     if (mIcon) {
         if (nvgIsFontIcon(mIcon)) {
             ih *= icon_scale();
-            nvgFontFace(ctx, "icons");
-            nvgFontSize(ctx, ih);
-            iw = nvgTextBounds(ctx, 0, 0, utf8(mIcon).data(), nullptr, nullptr)
+            iw = cache.measure(mTheme->mFontIcons, ih, NVG_ALIGN_LEFT | NVG_ALIGN_TOP, utf8(mIcon).data()).advance
                 + mSize.y() * 0.15f;
         } else {
             int w, h;
@@ -178,9 +176,8 @@ void Button::draw(NVGcontext *ctx) {
     }
 
     int fontSize = mFontSize == -1 ? mTheme->mButtonFontSize : mFontSize;
-    nvgFontSize(ctx, fontSize);
-    nvgFontFace(ctx, "sans-bold");
-    float tw = nvgTextBounds(ctx, 0,0, mCaption.c_str(), nullptr, nullptr);
+    auto &cache = TextLayoutCache::get(ctx);
+    float tw = cache.measure(mTheme->mFontBold, fontSize, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE, mCaption).advance;
 
     Vector2f center = mPos.cast<float>() + mSize.cast<float>() * 0.5f;
     Vector2f textPos(center.x() - tw * 0.5f, center.y() - 1);
@@ -195,9 +192,7 @@ void Button::draw(NVGcontext *ctx) {
         float iw, ih = fontSize;
         if (nvgIsFontIcon(mIcon)) {
             ih *= icon_scale();
-            nvgFontSize(ctx, ih);
-            nvgFontFace(ctx, "icons");
-            iw = nvgTextBounds(ctx, 0, 0, icon.data(), nullptr, nullptr);
+            iw = cache.measure(mTheme->mFontIcons, ih, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE, icon.data()).advance;
         } else {
             int w, h;
             ih *= 0.9f;
@@ -237,7 +232,7 @@ void Button::draw(NVGcontext *ctx) {
     if (haveDrawFlag(DrawText))
     {
       nvgFontSize(ctx, fontSize);
-      nvgFontFace(ctx, "sans-bold");
+      nvgFontFaceId(ctx, mTheme->mFontBold);
       nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
       nvgFillColor(ctx, mTheme->mTextColorShadow);
       nvgText(ctx, textPos.x(), textPos.y(), mCaption.c_str(), nullptr);
@@ -50,7 +50,7 @@ bool CheckBox::mouseButtonEvent(const Vector2i &p, int button, bool down,
 
 Vector2i CheckBox::preferredSize(NVGcontext *ctx) const {
     nvgFontSize(ctx, (float)fontSize());
-    nvgFontFace(ctx, "sans");
+    nvgFontFaceId(ctx, mTheme->mFontNormal);
     Vector2i prefSize( nvgTextBounds(ctx, 0, 0, mCaption.c_str(), nullptr, nullptr) + 1.8f * fontSize(),
                        fontSize() * 1.3f);
 
@@ -66,7 +66,7 @@ void CheckBox::draw(NVGcontext *ctx) {
     Widget::draw(ctx);
 
     nvgFontSize(ctx, (float)fontSize());
-    nvgFontFace(ctx, "sans");
+    nvgFontFaceId(ctx, mTheme->mFontNormal);
     nvgFillColor(ctx,
                  mEnabled ? mTheme->mTextColor : mTheme->mDisabledTextColor);
     nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
@@ -91,7 +91,7 @@ void CheckBox::draw(NVGcontext *ctx) {
 
     if (mChecked) {
         nvgFontSize(ctx, mSize.y() * icon_scale());
-        nvgFontFace(ctx, "icons");
+        nvgFontFaceId(ctx, mTheme->mFontIcons);
         nvgFillColor(ctx, mEnabled ? mTheme->mIconColor
                                    : mTheme->mDisabledTextColor);
         nvgTextAlign(ctx, NVG_ALIGN_CENTER | NVG_ALIGN_MIDDLE);
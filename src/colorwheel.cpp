@@ -13,6 +13,7 @@
 
 #include <nanogui/colorwheel.h>
 #include <nanogui/theme.h>
+#include <nanogui/screen.h>
 #include <nanovg.h>
 #include <nanogui/serializer/core.h>
 #include <algorithm>
@@ -139,6 +140,19 @@ void ColorWheel::draw(NVGcontext *ctx) {
     nvgRestore(vg); // restore save 2
 
     nvgRestore(vg); // restore save 1
+
+    /* Register the ring and the rotated triangle, so a click only needs a
+       lookup to know which region it started in */
+    if (Screen *scr = screen()) {
+        Vector2f center = Vector2f(cx, cy) + (absolutePosition() - mPos).cast<float>();
+        float angle = hue * NVG_PI * 2, c = cosf(angle), s = sinf(angle);
+        auto rotate = [&](float px, float py) {
+            return center + Vector2f(c * px - s * py, s * px + c * py);
+        };
+        PickBuffer &pick = scr->pickBuffer();
+        pick.addCircle(this, OuterCircle, center, r1, r0);
+        pick.addTriangle(this, InnerTriangle, rotate(r, 0), rotate(ax, ay), rotate(bx, by));
+    }
 }
 
 bool ColorWheel::mouseButtonEvent(const Vector2i &p, int button, bool down,
@@ -148,7 +162,13 @@ bool ColorWheel::mouseButtonEvent(const Vector2i &p, int button, bool down,
         return false;
 
     if (down) {
-        mDragRegion = adjustPosition(p);
+        Screen *scr = screen();
+        if (scr && scr->pickBuffer().contains(this)) {
+            int region = scr->pickBuffer().pick(this, p + parent()->absolutePosition());
+            mDragRegion = region < 0 ? None : adjustPosition(p, (Region) region);
+        } else {
+            mDragRegion = adjustPosition(p);
+        }
         return mDragRegion != None;
     } else {
         mDragRegion = None;
@@ -11,6 +11,8 @@
 
 #include <nanogui/combobox.h>
 #include <nanogui/layout.h>
+#include <nanogui/textbox.h>
+#include <nanogui/virtuallist.h>
 #include <nanogui/serializer/core.h>
 #include <cassert>
 
@@ -19,26 +21,56 @@ NAMESPACE_BEGIN(nanogui)
 RTTI_IMPLEMENT_INFO(ComboBox, PopupButton)
 
 ComboBox::ComboBox(Widget *parent) : PopupButton(parent), mSelectedIndex(0) {
+    initPopup();
 }
 
 ComboBox::ComboBox(Widget *parent, const std::vector<std::string> &items)
     : PopupButton(parent), mSelectedIndex(0) {
+    initPopup();
     setItems(items);
 }
 
 ComboBox::ComboBox(Widget *parent, const std::vector<std::string> &items, const std::vector<std::string> &itemsShort)
     : PopupButton(parent), mSelectedIndex(0) {
+    initPopup();
     setItems(items, itemsShort);
 }
 
+void ComboBox::initPopup() {
+    mPopup->withLayout<GroupLayout>(10);
+
+    mSearch = new TextBox(mPopup);
+    mSearch->setEditable(true);
+    mSearch->setAlignment(TextBox::Alignment::Left);
+    mSearch->setPlaceholder("Search");
+    mSearch->setVisible(false);
+    mSearch->setEditCallback([this](const std::string &text, bool) { setFilter(text); });
+    mSearch->setCallback([this](const std::string &) {
+        /* Enter picks the first match */
+        if (mList->rowCount() > 0)
+            selectItem(mList->itemAtRow(0));
+        return true;
+    });
+
+    mList = new VirtualList(mPopup);
+    mList->setCallback([this](int index) { selectItem(index); });
+}
+
+void ComboBox::selectItem(int index) {
+    setSelectedIndex(index);
+    setPushed(false);
+    popup()->setVisible(false);
+    if (mCallback)
+        mCallback(index);
+}
+
 void ComboBox::setSelectedIndex(int idx) {
-    if (mItemsShort.empty())
+    if (mItemsShort.empty() || idx < 0 || idx >= (int) mItemsShort.size())
         return;
-    const std::vector<Widget *> &children = popup()->children();
-    ((Button *) children[mSelectedIndex])->setPushed(false);
-    ((Button *) children[idx])->setPushed(true);
     mSelectedIndex = idx;
     setCaption(mItemsShort[idx]);
+    mList->setSelectedIndex(idx);
+    mList->scrollToItem(idx);
 }
 
 void ComboBox::setItems(const std::vector<std::string> &items, const std::vector<std::string> &itemsShort) {
@@ -47,26 +79,34 @@ void ComboBox::setItems(const std::vector<std::string> &items, const std::vector
     mItemsShort = itemsShort;
     if (mSelectedIndex < 0 || mSelectedIndex >= (int) items.size())
         mSelectedIndex = 0;
-    while (mPopup->childCount() != 0)
-        mPopup->removeChild(mPopup->childCount()-1);
-    mPopup->withLayout<GroupLayout>(10);
-    int index = 0;
-    for (const auto &str: items) {
-        auto& button = mPopup->button(str);
-        button.setFlags(Button::RadioButton);
-        button.setCallback([&, index] {
-            mSelectedIndex = index;
-            setCaption(mItemsShort[index]);
-            setPushed(false);
-            popup()->setVisible(false);
-            if (mCallback)
-                mCallback(index);
-        });
-        index++;
-    }
+
+    /* No widget per item: the list asks for the text of the visible rows */
+    mIndexDirty = true;
+    mSearch->setValue("");
+    mSearch->setVisible((int) mItems.size() >= mSearchThreshold);
+    mList->setItems((int) mItems.size(),
+                    [this](int index) -> const std::string & { return mItems[index]; });
     setSelectedIndex(mSelectedIndex);
 }
 
+void ComboBox::setFilter(const std::string &text) {
+    if (text.empty()) {
+        mList->clearVisibleItems();
+    } else {
+        if (mIndexDirty) {
+            mIndex.build(mItems);
+            mIndexDirty = false;
+        }
+        mList->setVisibleItems(mIndex.search(text));
+    }
+    mList->scrollToItem(mSelectedIndex);
+}
+
+void ComboBox::setSearchThreshold(int threshold) {
+    mSearchThreshold = threshold;
+    mSearch->setVisible((int) mItems.size() >= mSearchThreshold);
+}
+
 bool ComboBox::scrollEvent(const Vector2i &p, const Vector2f &rel) {
     if (rel.y() < 0) {
         setSelectedIndex(std::min(mSelectedIndex+1, (int)(items().size()-1)));
@@ -10,6 +10,8 @@
 */
 
 #include <nanogui/screen.h>
+#include <nanogui/imageloader.h>
+#include <nanogui/imagecache.h>
 
 #if defined(_WIN32)
 #  include <windows.h>
@@ -17,8 +19,13 @@
 
 #include <nanovg.h>
 #include <map>
+#include <limits>
+#include <vector>
 #include <thread>
-#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <memory>
 #include <algorithm>
 #include <iostream>
 
@@ -67,6 +74,102 @@ bool isPointInsideRect(const Vector2i& p, const Vector4i& r)
 }
 
 static bool mainloop_active = false;
+static bool parallel_layout = false;
+
+void appSetParallelLayout(bool enabled) { parallel_layout = enabled; }
+bool appParallelLayout() { return parallel_layout; }
+
+/* Threads laying out screens in parallel, started on first use and kept
+   until the main loop exits. The main thread takes part in every batch */
+class LayoutPool {
+public:
+    ~LayoutPool() {
+        {
+            std::lock_guard<std::mutex> guard(mMutex);
+            mStop = true;
+        }
+        mWake.notify_all();
+        for (auto &worker : mWorkers)
+            worker.join();
+    }
+
+    void run(const std::vector<Screen*> &screens) {
+        size_t wanted = std::min(screens.size() - 1,
+                                 (size_t) std::max((int) std::thread::hardware_concurrency() - 1, 1));
+        while (mWorkers.size() < wanted)
+            mWorkers.emplace_back([this]() { workerLoop(); });
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mScreens = &screens;
+        mNext = 0;
+        mRemaining = screens.size();
+        mError = nullptr;
+        ++mBatch;
+        mWake.notify_all();
+        layoutNext(lock);
+        mDone.wait(lock, [this]() { return mRemaining == 0; });
+        mScreens = nullptr;
+
+        /* Rethrow the first exception raised during layout, once no
+           worker reads the screens anymore */
+        if (mError)
+            std::rethrow_exception(mError);
+    }
+
+private:
+    /* Lay out screens until none are left, called with the lock held */
+    void layoutNext(std::unique_lock<std::mutex> &lock) {
+        while (mScreens && mNext < mScreens->size()) {
+            Screen *screen = (*mScreens)[mNext++];
+            lock.unlock();
+            /* Always caught, a worker must not terminate and the main
+               thread must not leave run() before every screen is done */
+            std::exception_ptr error;
+            try {
+                screen->performPendingLayout();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            if (error && !mError)
+                mError = error;
+            if (--mRemaining == 0)
+                mDone.notify_all();
+        }
+    }
+
+    void workerLoop() {
+        std::unique_lock<std::mutex> lock(mMutex);
+        uint64_t seen = mBatch;
+        while (true) {
+            mWake.wait(lock, [&]() { return mStop || mBatch != seen; });
+            if (mStop)
+                return;
+            seen = mBatch;
+            layoutNext(lock);
+        }
+    }
+
+    std::mutex mMutex;
+    std::condition_variable mWake, mDone;
+    std::vector<std::thread> mWorkers;
+    const std::vector<Screen*> *mScreens = nullptr;
+    size_t mNext = 0, mRemaining = 0;
+    uint64_t mBatch = 0;
+    std::exception_ptr mError;
+    bool mStop = false;
+};
+
+static std::unique_ptr<LayoutPool> layout_pool;
+
+static void performPendingLayouts(const std::vector<Screen*> &screens) {
+    if (!parallel_layout || screens.size() < 2)
+        return; /* drawWidgets() lays out on the main thread */
+
+    if (!layout_pool)
+        layout_pool.reset(new LayoutPool());
+    layout_pool->run(screens);
+}
 
 void mainloop(int refresh) {
     if (mainloop_active)
@@ -74,28 +177,30 @@ void mainloop(int refresh) {
 
     mainloop_active = true;
 
-    std::thread refresh_thread;
-    if (refresh > 0) {
-        /* If there are no mouse/keyboard events, try to refresh the
-           view roughly every 50 ms (default); this is to support animations
-           such as progress bars while keeping the system load
-           reasonably low */
-        refresh_thread = std::thread(
-            [refresh]() {
-                std::chrono::milliseconds time(refresh);
-                while (mainloop_active) {
-                    std::this_thread::sleep_for(time);
-                    appPostEmptyEvent();
-                }
-            }
-        );
-    }
+    /* A screen is redrawn when it received input or one of its widgets
+       requested an animation frame. If ``refresh`` is positive, all screens
+       are additionally redrawn at least every ``refresh`` ms to support
+       widgets which are updated without notifying the screen. Wake ups that
+       cannot be attributed to any screen (e.g. appPostEmptyEvent() from
+       another thread) conservatively redraw everything */
+    const double infinity = std::numeric_limits<double>::infinity();
+    const double refreshInterval = refresh > 0 ? refresh / 1000.0 : infinity;
+    double lastRefresh = getTimeFromStart();
+    bool redrawAll = true;
 
 #if NANOGUI_USING_EXCEPTION
     try {
 #endif
         while (mainloop_active) {
             int numScreens = 0;
+            double now = getTimeFromStart();
+            if (redrawAll || now - lastRefresh >= refreshInterval) {
+                redrawAll = true;
+                lastRefresh = now;
+            }
+
+            double nextDeadline = lastRefresh + refreshInterval;
+            std::vector<Screen*> dirty;
             appForEachScreen([&](Screen* screen) {
                 if (!screen->visible()) {
                     return;
@@ -103,18 +208,47 @@ void mainloop(int refresh) {
                     screen->setVisible(false);
                     return;
                 }
-                screen->drawAll();
+                if (redrawAll || screen->redrawPending(now))
+                    dirty.push_back(screen);
                 numScreens++;
             });
 
+            /* Posted commands may change layouts, run them first */
+            for (auto screen : dirty)
+                screen->processPostedCommands();
+            performPendingLayouts(dirty);
+            for (auto screen : dirty) {
+                screen->clearRedrawRequests(now);
+                screen->drawAll();
+            }
+
+            appForEachScreen([&](Screen* screen) {
+                if (screen->visible())
+                    nextDeadline = std::min(nextDeadline, screen->nextAnimationTime());
+            });
+
             if (numScreens == 0) {
                 /* Give up if there was nothing to draw */
                 mainloop_active = false;
                 break;
             }
 
-            /* Wait for mouse/keyboard or empty refresh events */
-            appWaitEvents();
+            /* Sleep until mouse/keyboard/empty events or the next deadline */
+            now = getTimeFromStart();
+            if (nextDeadline == infinity)
+                appWaitEvents();
+            else if (nextDeadline > now)
+                appWaitEventsTimeout(nextDeadline - now);
+            else
+                appPollEvents();
+
+            now = getTimeFromStart();
+            bool attributed = false;
+            appForEachScreen([&](Screen* screen) {
+                if (screen->visible() && screen->redrawPending(now))
+                    attributed = true;
+            });
+            redrawAll = !attributed;
         }
 
         /* Process events once more */
@@ -125,9 +259,7 @@ void mainloop(int refresh) {
         leave();
     }
 #endif
-
-    if (refresh > 0)
-        refresh_thread.join();
+    layout_pool.reset();
 }
 
 void leave() {
@@ -160,22 +292,15 @@ std::array<char, 8> utf8(int c) {
 }
 
 int __nanogui_get_image(NVGcontext *ctx, const std::string &name, uint8_t *data, uint32_t size) {
-    static std::map<std::string, int> iconCache;
-    auto it = iconCache.find(name);
-    if (it != iconCache.end())
-        return it->second;
-    int iconID = nvgCreateImageMem(ctx, 0, data, size);
-    if (iconID == 0)
-        throw std::runtime_error("Unable to load resource data.");
-    iconCache[name] = iconID;
-    return iconID;
+    /* Image ids are only valid for the context they were created with */
+    return ImageCache::get(ctx).icon(name, data, size);
 }
 
-std::vector<std::pair<int, std::string>>
-loadImageDirectory(NVGcontext *ctx, const std::string &path,
-                   std::function<bool (const std::string&)> filter)
+static std::vector<std::string>
+listImageDirectory(const std::string &path,
+                   const std::function<bool (const std::string&)> &filter)
 {
-    std::vector<std::pair<int, std::string> > result;
+    std::vector<std::string> result;
 #if !defined(_WIN32)
     DIR *dp = opendir(path.c_str());
     if (!dp)
@@ -200,11 +325,7 @@ loadImageDirectory(NVGcontext *ctx, const std::string &path,
         }
         if (strstr(fname, "png") == nullptr && strstr(fname, "jpg") == nullptr)
             continue;
-        std::string fullName = path + "/" + std::string(fname);
-        int img = nvgCreateImage(ctx, fullName.c_str(), 0);
-        if (img == 0)
-            throw std::runtime_error("Could not open image data!");
-        result.push_back(std::make_pair(img, fullName));
+        result.push_back(path + "/" + std::string(fname));
 #if !defined(_WIN32)
     }
     closedir(dp);
@@ -215,6 +336,36 @@ loadImageDirectory(NVGcontext *ctx, const std::string &path,
     return result;
 }
 
+std::vector<std::pair<int, std::string>>
+loadImageDirectory(NVGcontext *ctx, const std::string &path,
+                   std::function<bool (const std::string&)> filter)
+{
+    std::vector<std::pair<int, std::string> > result;
+    for (const std::string &fullName : listImageDirectory(path, filter)) {
+        int img = nvgCreateImage(ctx, fullName.c_str(), 0);
+        if (img == 0)
+            throw std::runtime_error("Could not open image data!");
+        result.push_back(std::make_pair(img, fullName));
+    }
+    return result;
+}
+
+std::vector<std::pair<int, std::string>>
+loadImageDirectoryAsync(NVGcontext *ctx, const std::string &path,
+                        std::function<void(int, const std::string&)> callback,
+                        std::function<bool (const std::string&)> filter)
+{
+    AsyncImageLoader &loader = AsyncImageLoader::get(ctx);
+    std::vector<std::pair<int, std::string> > result;
+    for (const std::string &fullName : listImageDirectory(path, filter)) {
+        AsyncImageLoader::Callback done;
+        if (callback)
+            done = [callback, fullName](int img) { callback(img, fullName); };
+        result.push_back(std::make_pair(loader.request(fullName, done), fullName));
+    }
+    return result;
+}
+
 void logic_error(const char* err, const char* file, int line)
 {
   std::cout << err << " FILE:" << file << "  LINE:" << line;
@@ -61,7 +61,7 @@ void ContextMenuLabel::draw(NVGcontext* ctx)
 
   if (!mShortcut.empty())
   {
-    nvgFontFace(ctx, mFont.c_str());
+    nvgFontFaceId(ctx, fontHandle(ctx));
     nvgFontSize(ctx, fontSize());
     nvgFillColor(ctx, mTheme->mContextMenuShortcutTextColor);
 
@@ -81,7 +81,7 @@ void ContextMenuLabel::draw(NVGcontext* ctx)
 
   if (mChecked) {
     nvgFontSize(ctx, mSize.y() * icon_scale());
-    nvgFontFace(ctx, "icons");
+    nvgFontFaceId(ctx, mTheme->mFontIcons);
     nvgFillColor(ctx, mEnabled ? mTheme->mIconColor : mTheme->mDisabledTextColor);
     nvgTextAlign(ctx, NVG_ALIGN_CENTER | NVG_ALIGN_MIDDLE);
     nvgText(ctx, mPos.x() + mSize.x() - (mSize.y() * 0.5f + 1),
@@ -93,7 +93,7 @@ void ContextMenuLabel::draw(NVGcontext* ctx)
 Vector2i ContextMenuLabel::preferredSize(NVGcontext* ctx) const
 {
   Vector2i pf = Label::preferredSize(ctx);
-  nvgFontFace(ctx, mFont.c_str());
+  nvgFontFaceId(ctx, fontHandle(ctx));
   nvgFontSize(ctx, fontSize());
   nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
   int tw = nvgTextBounds(ctx, 0, 0, mShortcut.empty() ? "Ctrl+A" : mShortcut.c_str(), nullptr, nullptr) + 2;
@@ -11,6 +11,8 @@
 
 #include <nanogui/dropdownbox.h>
 #include <nanogui/layout.h>
+#include <nanogui/textbox.h>
+#include <nanogui/virtuallist.h>
 #include <nanovg.h>
 #include <nanogui/serializer/core.h>
 #include <algorithm>
@@ -107,7 +109,7 @@ public:
 
     int fontSize = mFontSize == -1 ? mTheme->mButtonFontSize : mFontSize;
     nvgFontSize(ctx, fontSize);
-    nvgFontFace(ctx, "sans-bold");
+    nvgFontFaceId(ctx, mTheme->mFontBold);
     float tw = nvgTextBounds(ctx, 0, 0, mCaption.c_str(), nullptr, nullptr);
 
     Vector2f center = mPos.cast<float>() + mSize.cast<float>() * 0.5f;
@@ -122,7 +124,7 @@ public:
       if (nvgIsFontIcon(mIcon)) {
         ih *= icon_scale();
         nvgFontSize(ctx, ih);
-        nvgFontFace(ctx, "icons");
+        nvgFontFaceId(ctx, mTheme->mFontIcons);
         iw = nvgTextBounds(ctx, 0, 0, icon.data(), nullptr, nullptr);
       }
       else {
@@ -166,7 +168,7 @@ public:
     }
 
     nvgFontSize(ctx, fontSize);
-    nvgFontFace(ctx, "sans-bold");
+    nvgFontFaceId(ctx, mTheme->mFontBold);
     nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
     nvgFillColor(ctx, mTheme->mTextColorShadow);
     nvgText(ctx, textPos.x(), textPos.y(), mCaption.c_str(), nullptr);
@@ -295,6 +297,27 @@ DropdownBox::DropdownBox(Widget *parent)
   mPopup->setSize(Vector2i(320, 250));
   mPopup->setVisible(false);
   mPopup->setAnchorPos(Vector2i(0, 0));
+  mPopup->setLayout(new GroupLayout(0,0,0,0));
+
+  DropdownListItem *header = new DropdownListItem(mPopup, "", false);
+  header->setPushed(false);
+  header->setCallback([this] { setPushed(false); popup()->setVisible(false); });
+
+  mSearch = new TextBox(mPopup);
+  mSearch->setEditable(true);
+  mSearch->setAlignment(TextBox::Alignment::Left);
+  mSearch->setPlaceholder("Search");
+  mSearch->setVisible(false);
+  mSearch->setEditCallback([this](const std::string &text, bool) { setFilter(text); });
+  mSearch->setCallback([this](const std::string &) {
+    /* Enter picks the first match */
+    if (mList->rowCount() > 0)
+      selectItem(mList->itemAtRow(0));
+    return true;
+  });
+
+  mList = new VirtualList(mPopup);
+  mList->setCallback([this](int index) { selectItem(index); });
 }
 
 DropdownBox::DropdownBox(Widget *parent, const std::vector<std::string> &items)
@@ -318,15 +341,21 @@ void DropdownBox::performLayout(NVGcontext *ctx) {
   }
 }
 
+void DropdownBox::selectItem(int index) {
+    setSelectedIndex(index);
+    setPushed(false);
+    if (mCallback)
+        mCallback(index);
+}
+
 void DropdownBox::setSelectedIndex(int idx) {
-    if (mItemsShort.empty())
+    if (mItemsShort.empty() || idx < 0 || idx >= (int) mItemsShort.size())
         return;
-    const std::vector<Widget *> &children = popup()->children();
-    ((Button *) children[mSelectedIndex])->setPushed(false);
-    ((Button *) children[idx])->setPushed(true);
     mSelectedIndex = idx;
     setCaption(mItemsShort[idx]);
     ((DropdownPopup*)mPopup)->updateCaption(mItemsShort[idx]);
+    mList->setSelectedIndex(idx);
+    mList->scrollToItem(idx);
 }
 
 void DropdownBox::setItems(const std::vector<std::string> &items, const std::vector<std::string> &itemsShort) {
@@ -336,31 +365,31 @@ void DropdownBox::setItems(const std::vector<std::string> &items, const std::vec
     if (mSelectedIndex < 0 || mSelectedIndex >= (int) items.size())
         mSelectedIndex = 0;
 
-    while (mPopup->childCount() != 0)
-      mPopup->removeChild(mPopup->childCount() - 1);
+    /* No widget per item: the list asks for the text of the visible rows */
+    mIndexDirty = true;
+    mSearch->setValue("");
+    mSearch->setVisible((int) mItems.size() >= mSearchThreshold);
+    mList->setItems((int) mItems.size(),
+                    [this](int index) -> const std::string & { return mItems[index]; });
+    setSelectedIndex(mSelectedIndex);
+}
 
-    mPopup->setLayout(new GroupLayout(0,0,0,0));
-    if (!items.empty())
-    {
-      DropdownListItem *button = new DropdownListItem(mPopup, items[mSelectedIndex], false);
-      button->setPushed(false);
-      button->setCallback([&] { setPushed(false); popup()->setVisible(false); });
+void DropdownBox::setFilter(const std::string &text) {
+    if (text.empty()) {
+        mList->clearVisibleItems();
+    } else {
+        if (mIndexDirty) {
+            mIndex.build(mItems);
+            mIndexDirty = false;
+        }
+        mList->setVisibleItems(mIndex.search(text));
     }
+    mList->scrollToItem(mSelectedIndex);
+}
 
-    int index = 0;
-    for (const auto &str: items) {
-        auto& button = mPopup->wdg<DropdownListItem>(str);
-        button.setFlags(Button::RadioButton);
-        button.setCallback([&, index] {
-            mSelectedIndex = index;
-            setCaption(mItemsShort[index]);
-            setPushed(false);
-            if (mCallback)
-                mCallback(index);
-        });
-        index++;
-    }
-    setSelectedIndex(mSelectedIndex);
+void DropdownBox::setSearchThreshold(int threshold) {
+    mSearchThreshold = threshold;
+    mSearch->setVisible((int) mItems.size() >= mSearchThreshold);
 }
 
 bool DropdownBox::mouseButtonEvent(const Vector2i &p, int button, bool down, int modifiers)
@@ -405,7 +434,7 @@ void DropdownBox::draw(NVGcontext* ctx) {
       mTextColor.w() == 0 ? mTheme->mTextColor : mTextColor;
 
     nvgFontSize(ctx, (mFontSize < 0 ? mTheme->mButtonFontSize : mFontSize) * icon_scale());
-    nvgFontFace(ctx, "icons");
+    nvgFontFaceId(ctx, mTheme->mFontIcons);
     nvgFillColor(ctx, mEnabled ? textColor : mTheme->mDisabledTextColor);
     nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
 
@@ -208,6 +208,14 @@ bool appWaitEvents(void)
   return false;
 }
 
+bool appWaitEventsTimeout(double timeout)
+{
+  MsgWaitForMultipleObjects(0, NULL, FALSE, (DWORD)(timeout * 1000), QS_ALLINPUT);
+
+  appPollEvents();
+  return false;
+}
+
 static bool dx11showCloseScreen = false;
 bool appPollEvents(void)
 {
@@ -1,5 +1,9 @@
 #include <nanogui/screen.h>
 #include <nanogui/theme.h>
+#include <nanogui/textcache.h>
+#include <nanogui/imageloader.h>
+#include <nanogui/imagecache.h>
+#include <nanogui/fontregistry.h>
 #include <nanogui/window.h>
 #include <nanogui/popup.h>
 #include <nanovg.h>
@@ -584,6 +588,10 @@ Screen::~Screen() {
         if (mCursors[i])
             DestroyIcon((HICON) mCursors[i]);
     }
+    AsyncImageLoader::release(mNVGContext);
+    ImageCache::release(mNVGContext);
+    TextLayoutCache::release(mNVGContext);
+    FontRegistry::release(mNVGContext);
     //if (mNVGContext)
     //    nvgDelete(mNVGContext);
     //if (mHwWindow && mShutdownOnDestruct)
@@ -655,6 +663,7 @@ bool Screen::resizeCallbackEvent(int, int) {
         return false;
 
     mFBSize = fbSize; mSize = size;
+    mRedrawRequested = true;
     mLastInteraction = getTimeFromStart();
 
     try {
@@ -213,6 +213,14 @@ bool appWaitEvents(void)
   return false;
 }
 
+bool appWaitEventsTimeout(double timeout)
+{
+  MsgWaitForMultipleObjects(0, NULL, FALSE, (DWORD)(timeout * 1000), QS_ALLINPUT);
+
+  appPollEvents();
+  return false;
+}
+
 static bool dx12showCloseScreen = false;
 bool appPollEvents(void)
 {
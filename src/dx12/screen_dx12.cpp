@@ -5,6 +5,10 @@ Port to dx12 by megai2
 */
 #include <nanogui/screen.h>
 #include <nanogui/theme.h>
+#include <nanogui/textcache.h>
+#include <nanogui/imageloader.h>
+#include <nanogui/imagecache.h>
+#include <nanogui/fontregistry.h>
 #include <nanogui/window.h>
 #include <nanogui/popup.h>
 #include <nanovg.h>
@@ -338,6 +342,10 @@ Screen::~Screen() {
         if (mCursors[i])
             DestroyIcon((HICON) mCursors[i]);
     }
+    AsyncImageLoader::release(mNVGContext);
+    ImageCache::release(mNVGContext);
+    TextLayoutCache::release(mNVGContext);
+    FontRegistry::release(mNVGContext);
     if (mNVGContext)
     nvgDeleteD3D12(mNVGContext);
 
@@ -415,6 +423,7 @@ bool Screen::resizeCallbackEvent(int, int) {
         return false;
 
     mFBSize = fbSize; mSize = size;
+    mRedrawRequested = true;
     mLastInteraction = getTimeFromStart();
 
     try {
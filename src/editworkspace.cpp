@@ -844,6 +844,7 @@ void EditorWorkspace::_drawSelectedElement(NVGcontext* ctx)
   else if (_currentMode == EditMode::SelectNewParent)
   {
     float value = std::fmod((float)getTimeFromStart(), 1.0f);
+    requestAnimationFrame(0.5f - std::fmod(value, 0.5f));
     Vector4i r = moveRect(mSelectedElement->rect(), offset);
     Color color(0, 0, 255, value > 0.5 ? 32 : 64);
     nvgBeginPath(ctx);
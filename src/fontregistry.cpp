@@ -0,0 +1,85 @@
+/*
+    src/fontregistry.cpp -- Per-context font name to handle mapping
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/fontregistry.h>
+#include <nanogui/textcache.h>
+#include <nanovg.h>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <stdexcept>
+
+NAMESPACE_BEGIN(nanogui)
+
+/* Locked only when a thread switches contexts, as in TextLayoutCache::get */
+static std::mutex fontRegistryMutex;
+static std::map<NVGcontext*, std::unique_ptr<FontRegistry>> fontRegistries;
+static std::atomic<uint64_t> fontRegistryGeneration { 0 };
+
+FontRegistry &FontRegistry::get(NVGcontext *ctx) {
+    thread_local NVGcontext *lastContext = nullptr;
+    thread_local FontRegistry *lastRegistry = nullptr;
+    thread_local uint64_t lastGeneration = 0;
+
+    uint64_t generation = fontRegistryGeneration.load(std::memory_order_acquire);
+    if (ctx == lastContext && generation == lastGeneration)
+        return *lastRegistry;
+
+    std::lock_guard<std::mutex> guard(fontRegistryMutex);
+    auto &registry = fontRegistries[ctx];
+    if (!registry)
+        registry.reset(new FontRegistry(ctx));
+    lastContext = ctx;
+    lastRegistry = registry.get();
+    lastGeneration = generation;
+    return *registry;
+}
+
+void FontRegistry::release(NVGcontext *ctx) {
+    std::lock_guard<std::mutex> guard(fontRegistryMutex);
+    fontRegistries.erase(ctx);
+    fontRegistryGeneration.fetch_add(1, std::memory_order_release);
+}
+
+int FontRegistry::resolve(const std::string &name) {
+    auto it = mHandles.find(name);
+    if (it != mHandles.end())
+        return it->second;
+    int handle = nvgFindFont(mContext, name.c_str());
+    /* Unknown fonts are not remembered, they may still be loaded later */
+    if (handle != -1)
+        mHandles[name] = handle;
+    return handle;
+}
+
+void FontRegistry::addFallback(const std::string &base, const std::string &fallback) {
+    int baseHandle = resolve(base), fallbackHandle = resolve(fallback);
+    if (baseHandle == -1 || fallbackHandle == -1)
+        throw std::runtime_error("FontRegistry::addFallback(): unknown font \"" +
+                                 (baseHandle == -1 ? base : fallback) + "\"");
+    auto &chain = mFallbacks[baseHandle];
+    if (std::find(chain.begin(), chain.end(), fallbackHandle) != chain.end())
+        return;
+    if (!nvgAddFallbackFontId(mContext, baseHandle, fallbackHandle))
+        throw std::runtime_error("FontRegistry::addFallback(): too many fallbacks for \"" + base + "\"");
+    chain.push_back(fallbackHandle);
+    /* Text measured before may now render with different glyphs */
+    TextLayoutCache::get(mContext).invalidateFont(baseHandle);
+}
+
+const std::vector<int> &FontRegistry::fallbacks(int font) const {
+    static const std::vector<int> none;
+    auto it = mFallbacks.find(font);
+    return it != mFallbacks.end() ? it->second : none;
+}
+
+NAMESPACE_END(nanogui)
@@ -58,6 +58,7 @@ bool appIsShouldCloseScreen(Screen* screen)
 }
 
 bool appWaitEvents() { glfwWaitEvents(); return true; }
+bool appWaitEventsTimeout(double timeout) { glfwWaitEventsTimeout(timeout); return true; }
 bool appPollEvents() { glfwPollEvents(); return true; }
 
 bool isKeyboardActionRelease(int action) { return action == GLFW_RELEASE; }
@@ -127,6 +127,8 @@ bool GLShader::init(const std::string &name,
         glAttachShader(mProgramShader, mGeometryShader);
 
     glLinkProgram(mProgramShader);
+    mUniformLocations.clear();
+    mAttribLocations.clear();
 
     GLint status;
     glGetProgramiv(mProgramShader, GL_LINK_STATUS, &status);
@@ -148,12 +150,64 @@ void GLShader::bind() {
 }
 
 GLint GLShader::attrib(const std::string &name, bool warn) const {
-    GLint id = glGetAttribLocation(mProgramShader, name.c_str());
+    auto it = mAttribLocations.find(name);
+    GLint id;
+    if (it != mAttribLocations.end()) {
+        id = it->second;
+    } else {
+        id = glGetAttribLocation(mProgramShader, name.c_str());
+        mAttribLocations[name] = id;
+    }
     if (id == -1 && warn)
         std::cerr << mName << ": warning: did not find attrib " << name << std::endl;
     return id;
 }
 
+GLShader::AttribHandle GLShader::attribHandle(const std::string &name, bool warn) {
+    AttribHandle handle;
+    auto it = mAttribSlots.find(name);
+    if (it != mAttribSlots.end()) {
+        handle.slot = &it->second;
+        return handle;
+    }
+
+    GLint attribID = -1;
+    if (name != "indices") {
+        attribID = attrib(name, warn);
+        if (attribID < 0)
+            return handle;
+    }
+
+    AttribSlot &slot = mAttribSlots[name];
+    slot.name = name;
+    slot.attribID = attribID;
+    handle.slot = &slot;
+    return handle;
+}
+
+GLShader::Buffer &GLShader::slotBuffer(AttribSlot &slot) {
+    if (slot.buffer)
+        return *slot.buffer;
+
+    /* The entry may already exist, e.g. restored by the serializer */
+    auto it = mBufferObjects.find(slot.name);
+    if (it == mBufferObjects.end()) {
+        Buffer buffer;
+        glGenBuffers(1, &buffer.id);
+        buffer.glType = 0;
+        buffer.dim = 0;
+        buffer.compSize = 0;
+        buffer.size = 0;
+        buffer.version = -1;
+        it = mBufferObjects.emplace(slot.name, buffer).first;
+    }
+    Buffer &buffer = it->second;
+    buffer.target = slot.name == "indices" ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
+    buffer.attribID = slot.attribID;
+    slot.buffer = &buffer;
+    return buffer;
+}
+
 void GLShader::setUniform(const std::string &name, const GLUniformBuffer &buf, bool warn) {
     GLuint blockIndex = glGetUniformBlockIndex(mProgramShader, name.c_str());
     if (blockIndex == GL_INVALID_INDEX) {
@@ -165,7 +219,14 @@ void GLShader::setUniform(const std::string &name, const GLUniformBuffer &buf, b
 }
 
 GLint GLShader::uniform(const std::string &name, bool warn) const {
-    GLint id = glGetUniformLocation(mProgramShader, name.c_str());
+    auto it = mUniformLocations.find(name);
+    GLint id;
+    if (it != mUniformLocations.end()) {
+        id = it->second;
+    } else {
+        id = glGetUniformLocation(mProgramShader, name.c_str());
+        mUniformLocations[name] = id;
+    }
     if (id == -1 && warn)
         std::cerr << mName << ": warning: did not find uniform " << name << std::endl;
     return id;
@@ -174,49 +235,86 @@ GLint GLShader::uniform(const std::string &name, bool warn) const {
 void GLShader::uploadAttrib(const std::string &name, size_t size, int dim,
                             uint32_t compSize, GLuint glType, bool integral,
                             const void *data, int version) {
-    int attribID = 0;
-    if (name != "indices") {
-        attribID = attrib(name);
-        if (attribID < 0)
-            return;
-    }
-
-    GLuint bufferID;
-    auto it = mBufferObjects.find(name);
-    if (it != mBufferObjects.end()) {
-        Buffer &buffer = it->second;
-        bufferID = it->second.id;
-        buffer.version = version;
-        buffer.size = (GLuint) size;
-        buffer.compSize = compSize;
+    AttribHandle handle = attribHandle(name);
+    if (handle.valid())
+        uploadAttrib(handle, size, dim, compSize, glType, integral, data, version);
+}
+
+/* Make sure the buffer store can hold 'totalSize' bytes. Growing reallocates;
+   otherwise the old store is orphaned so the driver can hand out fresh memory
+   instead of stalling on draw calls that still read the previous contents. */
+static void reserveBuffer_helper(GLShader::Buffer &buffer, size_t totalSize, const void *data) {
+    glBindBuffer(buffer.target, buffer.id);
+    if (totalSize > buffer.capacity || buffer.capacity == 0) {
+        glBufferData(buffer.target, totalSize, data, GL_DYNAMIC_DRAW);
+        buffer.capacity = totalSize;
     } else {
-        glGenBuffers(1, &bufferID);
-        Buffer buffer;
-        buffer.id = bufferID;
-        buffer.glType = glType;
-        buffer.dim = dim;
-        buffer.compSize = compSize;
-        buffer.size = (GLuint) size;
-        buffer.version = version;
-        mBufferObjects[name] = buffer;
+        glBufferData(buffer.target, buffer.capacity, nullptr, GL_DYNAMIC_DRAW);
+        if (data && totalSize > 0)
+            glBufferSubData(buffer.target, 0, totalSize, data);
     }
-    size_t totalSize = size * (size_t) compSize;
+}
 
-    if (name == "indices") {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bufferID);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, totalSize, data, GL_DYNAMIC_DRAW);
-    } else {
-        glBindBuffer(GL_ARRAY_BUFFER, bufferID);
-        glBufferData(GL_ARRAY_BUFFER, totalSize, data, GL_DYNAMIC_DRAW);
+static void updateAttribPointer_helper(GLShader::Buffer &buffer, size_t size, int dim,
+                                       uint32_t compSize, GLuint glType, bool integral,
+                                       int version) {
+    buffer.glType = glType;
+    buffer.dim = dim;
+    buffer.compSize = compSize;
+    buffer.size = (GLuint) size;
+    buffer.version = version;
+
+    if (buffer.target == GL_ARRAY_BUFFER) {
         if (size == 0) {
-            glDisableVertexAttribArray(attribID);
+            glDisableVertexAttribArray(buffer.attribID);
         } else {
-            glEnableVertexAttribArray(attribID);
-            glVertexAttribPointer(attribID, dim, glType, integral, 0, 0);
+            glEnableVertexAttribArray(buffer.attribID);
+            glVertexAttribPointer(buffer.attribID, dim, glType, integral, 0, 0);
         }
     }
 }
 
+void GLShader::uploadAttrib(AttribHandle handle, size_t size, int dim,
+                            uint32_t compSize, GLuint glType, bool integral,
+                            const void *data, int version) {
+    if (!handle.valid())
+        return;
+
+    Buffer &buffer = slotBuffer(*handle.slot);
+    reserveBuffer_helper(buffer, size * (size_t) compSize, data);
+    updateAttribPointer_helper(buffer, size, dim, compSize, glType, integral, version);
+}
+
+void *GLShader::mapAttrib(AttribHandle handle, size_t size, int dim,
+                          uint32_t compSize, GLuint glType, bool integral,
+                          int version) {
+    if (!handle.valid())
+        return nullptr;
+
+    Buffer &buffer = slotBuffer(*handle.slot);
+    size_t totalSize = size * (size_t) compSize;
+    if (totalSize == 0)
+        return nullptr;
+
+    glBindBuffer(buffer.target, buffer.id);
+    if (totalSize > buffer.capacity) {
+        glBufferData(buffer.target, totalSize, nullptr, GL_DYNAMIC_DRAW);
+        buffer.capacity = totalSize;
+    }
+    updateAttribPointer_helper(buffer, size, dim, compSize, glType, integral, version);
+
+    return glMapBufferRange(buffer.target, 0, totalSize,
+                            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+}
+
+void GLShader::unmapAttrib(AttribHandle handle) {
+    if (!handle.valid() || !handle.slot->buffer)
+        return;
+
+    glBindBuffer(handle.slot->buffer->target, handle.slot->buffer->id);
+    glUnmapBuffer(handle.slot->buffer->target);
+}
+
 void GLShader::downloadAttrib(const std::string &name, size_t size, int /* dim */,
                              uint32_t compSize, GLuint /* glType */, void *data) {
     auto it = mBufferObjects.find(name);
@@ -268,6 +366,9 @@ void GLShader::freeAttrib(const std::string &name) {
         glDeleteBuffers(1, &it->second.id);
         mBufferObjects.erase(it);
     }
+    auto slot = mAttribSlots.find(name);
+    if (slot != mAttribSlots.end())
+        slot->second.buffer = nullptr;
 }
 
 void GLShader::drawIndexed(int type, uint32_t offset_, uint32_t count_) {
@@ -296,12 +397,16 @@ void GLShader::free() {
     for (auto &buf: mBufferObjects)
         glDeleteBuffers(1, &buf.second.id);
     mBufferObjects.clear();
+    mAttribSlots.clear();
 
     if (mVertexArrayObject) {
         glDeleteVertexArrays(1, &mVertexArrayObject);
         mVertexArrayObject = 0;
     }
 
+    mUniformLocations.clear();
+    mAttribLocations.clear();
+
     glDeleteProgram(mProgramShader); mProgramShader = 0;
     glDeleteShader(mVertexShader);   mVertexShader = 0;
     glDeleteShader(mFragmentShader); mFragmentShader = 0;
@@ -13,6 +13,10 @@
 
 #include <nanogui/screen.h>
 #include <nanogui/theme.h>
+#include <nanogui/textcache.h>
+#include <nanogui/imageloader.h>
+#include <nanogui/imagecache.h>
+#include <nanogui/fontregistry.h>
 #include <nanogui/window.h>
 #include <nanogui/popup.h>
 #include <nanogui/opengl.h>
@@ -368,6 +372,10 @@ Screen::~Screen() {
         if (mCursors[i])
             glfwDestroyCursor((GLFWcursor*)mCursors[i]);
     }
+    AsyncImageLoader::release(mNVGContext);
+    ImageCache::release(mNVGContext);
+    TextLayoutCache::release(mNVGContext);
+    FontRegistry::release(mNVGContext);
     if (mNVGContext)
         nvgDeleteGL3(mNVGContext);
     if (mHwWindow && mShutdownOnDestruct)
@@ -462,6 +470,7 @@ bool Screen::resizeCallbackEvent(int, int) {
         return false;
 
     mFBSize = fbSize; mSize = size;
+    mRedrawRequested = true;
     mLastInteraction = glfwGetTime();
 
     try {
@@ -55,7 +55,7 @@ void Graph::draw(NVGcontext *ctx) {
     nvgFillColor(ctx, mForegroundColor);
     nvgFill(ctx);
 
-    nvgFontFace(ctx, "sans");
+    nvgFontFaceId(ctx, mTheme->mFontNormal);
 
     if (!mCaption.empty()) {
         nvgFontSize(ctx, 14.0f);
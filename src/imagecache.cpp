@@ -0,0 +1,163 @@
+/*
+    src/imagecache.cpp -- Per-context cache of GPU images with reference
+    counted handles and a memory budget
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/imagecache.h>
+#include <nanovg.h>
+#include <fstream>
+#include <iterator>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+NAMESPACE_BEGIN(nanogui)
+
+static std::mutex imageCacheRegistryMutex;
+static std::map<NVGcontext*, std::unique_ptr<ImageCache>> imageCacheRegistry;
+
+ImageCache &ImageCache::get(NVGcontext *ctx) {
+    std::lock_guard<std::mutex> guard(imageCacheRegistryMutex);
+    auto &cache = imageCacheRegistry[ctx];
+    if (!cache)
+        cache.reset(new ImageCache(ctx));
+    return *cache;
+}
+
+void ImageCache::release(NVGcontext *ctx) {
+    std::lock_guard<std::mutex> guard(imageCacheRegistryMutex);
+    imageCacheRegistry.erase(ctx);
+}
+
+ImageCache::~ImageCache() {
+    /* Handles may outlive the context, leave them with an invalid image */
+    for (auto &entry : mEntries) {
+        nvgDeleteImage(mContext, entry.image->image);
+        entry.image->image = 0;
+    }
+}
+
+/* FNV-1a over the encoded data and the image flags */
+static uint64_t contentHash(const uint8_t *data, size_t size, int imageFlags) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < size; ++i)
+        hash = (hash ^ data[i]) * 0x100000001b3ULL;
+    return (hash ^ (uint64_t) imageFlags) * 0x100000001b3ULL;
+}
+
+static std::string nameKey(const std::string &name, int imageFlags) {
+    return std::to_string(imageFlags) + ":" + name;
+}
+
+ImageCache::Iterator ImageCache::find(const std::string &name, const uint8_t *data,
+                                      size_t size, int imageFlags) {
+    std::string key = nameKey(name, imageFlags);
+    auto byName = mByName.find(key);
+    if (byName != mByName.end()) {
+        mEntries.splice(mEntries.begin(), mEntries, byName->second);
+        return byName->second;
+    }
+
+    uint64_t hash = contentHash(data, size, imageFlags);
+    auto byHash = mByHash.find(hash);
+    if (byHash != mByHash.end() && byHash->second->data.size() == size &&
+        (size == 0 || memcmp(byHash->second->data.data(), data, size) == 0)) {
+        /* Same data under another name */
+        Iterator it = byHash->second;
+        it->names.push_back(key);
+        mByName[key] = it;
+        mEntries.splice(mEntries.begin(), mEntries, it);
+        return it;
+    }
+
+    int image = nvgCreateImageMem(mContext, imageFlags, (unsigned char *) data, (int) size);
+    if (image == 0)
+        throw std::runtime_error("ImageCache: unable to decode image \"" + name + "\"!");
+
+    Entry entry;
+    entry.image = std::make_shared<CachedImage>();
+    entry.image->image = image;
+    nvgImageSize(mContext, image, &entry.image->width, &entry.image->height);
+    entry.image->bytes = (size_t) entry.image->width * entry.image->height * 4;
+    entry.hash = hash;
+    entry.data.assign(data, data + size);
+    entry.names.push_back(key);
+
+    mEntries.push_front(std::move(entry));
+    Iterator it = mEntries.begin();
+    mByName[key] = it;
+    /* On a hash collision the image is only found by name */
+    if (byHash == mByHash.end())
+        mByHash[hash] = it;
+    mMemoryUsage += it->image->bytes;
+    return it;
+}
+
+ImageHandle ImageCache::load(const std::string &name, const uint8_t *data,
+                             size_t size, int imageFlags) {
+    Iterator it = find(name, data, size, imageFlags);
+    /* Take the handle first so that trim() cannot evict the new image */
+    ImageHandle handle = it->image;
+    trim();
+    return handle;
+}
+
+ImageHandle ImageCache::loadFile(const std::string &path, int imageFlags) {
+    auto byName = mByName.find(nameKey(path, imageFlags));
+    if (byName != mByName.end()) {
+        mEntries.splice(mEntries.begin(), mEntries, byName->second);
+        return byName->second->image;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("ImageCache: unable to open \"" + path + "\"!");
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)),
+                              std::istreambuf_iterator<char>());
+    return load(path, data.data(), data.size(), imageFlags);
+}
+
+int ImageCache::icon(const std::string &name, const uint8_t *data, size_t size) {
+    Iterator it = find(name, data, size, 0);
+    it->pinned = true;
+    return it->image->image;
+}
+
+void ImageCache::evict(Iterator it) {
+    for (const auto &key : it->names)
+        mByName.erase(key);
+    auto byHash = mByHash.find(it->hash);
+    if (byHash != mByHash.end() && byHash->second == it)
+        mByHash.erase(byHash);
+    mMemoryUsage -= it->image->bytes;
+    nvgDeleteImage(mContext, it->image->image);
+    it->image->image = 0;
+    mEntries.erase(it);
+}
+
+void ImageCache::trim() {
+    auto it = mEntries.end();
+    while (mMemoryUsage > mBudget && it != mEntries.begin()) {
+        --it;
+        if (evictable(*it))
+            evict(it++);
+    }
+}
+
+void ImageCache::purgeUnused() {
+    for (auto it = mEntries.begin(); it != mEntries.end(); ) {
+        if (evictable(*it))
+            evict(it++);
+        else
+            ++it;
+    }
+}
+
+NAMESPACE_END(nanogui)
@@ -0,0 +1,285 @@
+/*
+    src/imageloader.cpp -- Per-context image loader decoding files on
+    worker threads
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/imageloader.h>
+#include <nanovg.h>
+#include <stb_image.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+
+NAMESPACE_BEGIN(nanogui)
+
+static std::mutex loaderRegistryMutex;
+static std::map<NVGcontext*, std::unique_ptr<AsyncImageLoader>> loaderRegistry;
+
+AsyncImageLoader &AsyncImageLoader::get(NVGcontext *ctx) {
+    std::lock_guard<std::mutex> guard(loaderRegistryMutex);
+    auto &loader = loaderRegistry[ctx];
+    if (!loader)
+        loader.reset(new AsyncImageLoader(ctx));
+    return *loader;
+}
+
+AsyncImageLoader *AsyncImageLoader::find(NVGcontext *ctx) {
+    std::lock_guard<std::mutex> guard(loaderRegistryMutex);
+    auto it = loaderRegistry.find(ctx);
+    return it != loaderRegistry.end() ? it->second.get() : nullptr;
+}
+
+void AsyncImageLoader::release(NVGcontext *ctx) {
+    std::unique_ptr<AsyncImageLoader> loader;
+    {
+        std::lock_guard<std::mutex> guard(loaderRegistryMutex);
+        auto it = loaderRegistry.find(ctx);
+        if (it == loaderRegistry.end())
+            return;
+        loader = std::move(it->second);
+        loaderRegistry.erase(it);
+    }
+    /* Joining the workers may take a moment, don't hold the registry lock */
+    loader.reset();
+}
+
+AsyncImageLoader::AsyncImageLoader(NVGcontext *ctx) : mContext(ctx) {
+    /* Leave one core to the UI thread */
+    mThreadCount = std::max((int) std::thread::hardware_concurrency() - 1, 1);
+}
+
+AsyncImageLoader::~AsyncImageLoader() {
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mStop = true;
+        mJobs.clear();
+    }
+    mCondition.notify_all();
+    for (auto &worker : mWorkers)
+        worker.join();
+    for (auto &decoded : mDecoded)
+        if (decoded.pixels)
+            stbi_image_free(decoded.pixels);
+    /* Uploaded images belong to the context, which is deleted right after */
+}
+
+int AsyncImageLoader::placeholder() {
+    if (mPlaceholder == 0) {
+        const unsigned char transparent[4] = { 0, 0, 0, 0 };
+        mPlaceholder = nvgCreateImageRGBA(mContext, 1, 1, 0, transparent);
+    }
+    return mPlaceholder;
+}
+
+int AsyncImageLoader::request(const std::string &path, const Callback &callback,
+                              int imageFlags) {
+    auto it = mImages.find(path);
+    if (it != mImages.end()) {
+        if (callback)
+            callback(it->second);
+        return it->second;
+    }
+
+    auto waiting = mWaiting.find(path);
+    if (waiting == mWaiting.end()) {
+        waiting = mWaiting.emplace(path, std::vector<Callback>()).first;
+        enqueue(Job { path, imageFlags, 0, 0, nullptr });
+    }
+    if (callback)
+        waiting->second.push_back(callback);
+    return placeholder();
+}
+
+void AsyncImageLoader::requestThumbnail(const std::string &path, int size,
+                                        const ThumbnailCallback &callback) {
+    if (size <= 0)
+        throw std::runtime_error("AsyncImageLoader::requestThumbnail(): invalid size!");
+    /* Callbacks stay on the UI thread, the workers only see the ticket */
+    uint64_t ticket = ++mNextTicket;
+    mThumbnailCallbacks[ticket] = callback;
+    enqueue(Job { path, 0, size, ticket, nullptr });
+}
+
+uint64_t AsyncImageLoader::requestPixels(const Producer &producer,
+                                         const Callback &callback, int imageFlags) {
+    uint64_t ticket = ++mNextTicket;
+    mPixelCallbacks[ticket] = callback;
+    enqueue(Job { std::string(), imageFlags, 0, ticket, producer });
+    return ticket;
+}
+
+void AsyncImageLoader::cancel(uint64_t ticket) {
+    if (mThumbnailCallbacks.erase(ticket) + mPixelCallbacks.erase(ticket) == 0)
+        return;
+    /* Jobs that already started are dropped once they are done */
+    std::lock_guard<std::mutex> guard(mMutex);
+    for (auto it = mJobs.begin(); it != mJobs.end(); ++it) {
+        if (it->ticket == ticket) {
+            mJobs.erase(it);
+            break;
+        }
+    }
+}
+
+void AsyncImageLoader::enqueue(Job &&job) {
+    if (mWorkers.empty())
+        startWorkers();
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mJobs.push_back(std::move(job));
+    }
+    mCondition.notify_one();
+}
+
+void AsyncImageLoader::startWorkers() {
+    for (int i = 0; i < mThreadCount; ++i)
+        mWorkers.emplace_back([this] { workerLoop(); });
+}
+
+/* Crop the centered square of an RGBA image and box filter it to size x size */
+static std::vector<uint8_t> makeThumbnail(const unsigned char *pixels, int width,
+                                          int height, int size) {
+    std::vector<uint8_t> result((size_t) size * size * 4);
+    int side = std::min(width, height);
+    int ox = (width - side) / 2, oy = (height - side) / 2;
+    for (int y = 0; y < size; ++y) {
+        int y0 = oy + y * side / size;
+        int y1 = std::max(oy + (y + 1) * side / size, y0 + 1);
+        for (int x = 0; x < size; ++x) {
+            int x0 = ox + x * side / size;
+            int x1 = std::max(ox + (x + 1) * side / size, x0 + 1);
+            uint32_t sum[4] = { 0, 0, 0, 0 };
+            for (int sy = y0; sy < y1; ++sy) {
+                const unsigned char *row = pixels + ((size_t) sy * width + x0) * 4;
+                for (int sx = x0; sx < x1; ++sx, row += 4)
+                    for (int c = 0; c < 4; ++c)
+                        sum[c] += row[c];
+            }
+            uint32_t count = (uint32_t) ((y1 - y0) * (x1 - x0));
+            uint8_t *out = result.data() + ((size_t) y * size + x) * 4;
+            for (int c = 0; c < 4; ++c)
+                out[c] = (uint8_t) (sum[c] / count);
+        }
+    }
+    return result;
+}
+
+void AsyncImageLoader::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this] { return mStop || !mJobs.empty(); });
+            if (mStop)
+                return;
+            job = std::move(mJobs.front());
+            mJobs.pop_front();
+        }
+
+        Decoded decoded { std::move(job), 0, 0, nullptr, {} };
+        if (decoded.job.producer) {
+            if (!decoded.job.producer(decoded.rgba, decoded.width, decoded.height) ||
+                decoded.rgba.size() < (size_t) decoded.width * decoded.height * 4)
+                decoded.rgba.clear();
+            /* Release whatever the producer captured on this thread */
+            decoded.job.producer = nullptr;
+        } else {
+            int channels;
+            decoded.pixels = stbi_load(decoded.job.path.c_str(), &decoded.width,
+                                       &decoded.height, &channels, 4);
+            if (decoded.pixels && decoded.job.thumbSize > 0) {
+                decoded.rgba = makeThumbnail(decoded.pixels, decoded.width,
+                                             decoded.height, decoded.job.thumbSize);
+                stbi_image_free(decoded.pixels);
+                decoded.pixels = nullptr;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> guard(mMutex);
+            if (mStop) {
+                if (decoded.pixels)
+                    stbi_image_free(decoded.pixels);
+                return;
+            }
+            mDecoded.push_back(std::move(decoded));
+        }
+        /* Wake up the main loop so that the image gets uploaded */
+        appPostEmptyEvent();
+    }
+}
+
+bool AsyncImageLoader::processUploads() {
+    double start = getTimeFromStart();
+    while (true) {
+        Decoded decoded;
+        {
+            std::lock_guard<std::mutex> guard(mMutex);
+            if (mDecoded.empty())
+                return false;
+            decoded = std::move(mDecoded.front());
+            mDecoded.pop_front();
+        }
+
+        const Job &job = decoded.job;
+        if (job.ticket != 0 && job.thumbSize == 0) {
+            auto it = mPixelCallbacks.find(job.ticket);
+            if (it != mPixelCallbacks.end()) {
+                Callback callback = std::move(it->second);
+                mPixelCallbacks.erase(it);
+                int image = 0;
+                if (!decoded.rgba.empty())
+                    image = nvgCreateImageRGBA(mContext, decoded.width, decoded.height,
+                                               job.flags, decoded.rgba.data());
+                if (callback)
+                    callback(image);
+                else if (image)
+                    nvgDeleteImage(mContext, image);
+            }
+        } else if (job.thumbSize > 0) {
+            auto it = mThumbnailCallbacks.find(job.ticket);
+            if (it != mThumbnailCallbacks.end()) {
+                ThumbnailCallback callback = std::move(it->second);
+                mThumbnailCallbacks.erase(it);
+                Thumbnail thumbnail;
+                thumbnail.path = job.path;
+                thumbnail.size = job.thumbSize;
+                thumbnail.rgba = std::move(decoded.rgba);
+                if (callback)
+                    callback(thumbnail);
+            }
+        } else {
+            int image = 0;
+            if (decoded.pixels) {
+                image = nvgCreateImageRGBA(mContext, decoded.width, decoded.height,
+                                           job.flags, decoded.pixels);
+                stbi_image_free(decoded.pixels);
+            }
+            /* Failed files are remembered as 0 so that polling widgets don't
+               queue them over and over again */
+            mImages[job.path] = image;
+
+            std::vector<Callback> callbacks;
+            auto waiting = mWaiting.find(job.path);
+            if (waiting != mWaiting.end()) {
+                callbacks = std::move(waiting->second);
+                mWaiting.erase(waiting);
+            }
+            for (auto &callback : callbacks)
+                callback(image);
+        }
+
+        if (getTimeFromStart() - start > mUploadBudget) {
+            std::lock_guard<std::mutex> guard(mMutex);
+            return !mDecoded.empty();
+        }
+    }
+}
+
+NAMESPACE_END(nanogui)
@@ -11,7 +11,10 @@
 */
 
 #include <nanogui/imagepanel.h>
+#include <nanogui/imageloader.h>
+#include <nanogui/screen.h>
 #include <nanovg.h>
+#include <cmath>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -62,53 +65,340 @@ Vector2i ImagePanel::preferredSize(NVGcontext *) const {
     );
 }
 
-void ImagePanel::draw(NVGcontext* ctx) {
-    Vector2i grid = gridSize();
+Vector2i ImagePanel::cellPosition(size_t index, const Vector2i &grid) const {
+    return mPos + Vector2i::Constant(mMargin) +
+        Vector2i((int) index % grid.x(), (int) index / grid.x()) * (mThumbSize + mSpacing);
+}
+
+void ImagePanel::drawImage(NVGcontext* ctx, size_t i, const Vector2i &p) {
+    int imgw, imgh;
+
+    nvgImageSize(ctx, mImages[i].first, &imgw, &imgh);
+    float iw, ih, ix, iy;
+    if (imgw < imgh) {
+        iw = mThumbSize;
+        ih = iw * (float)imgh / (float)imgw;
+        ix = 0;
+        iy = -(ih - mThumbSize) * 0.5f;
+    } else {
+        ih = mThumbSize;
+        iw = ih * (float)imgw / (float)imgh;
+        ix = -(iw - mThumbSize) * 0.5f;
+        iy = 0;
+    }
+
+    NVGpaint imgPaint = nvgImagePattern(
+        ctx, p.x() + ix, p.y()+ iy, iw, ih, 0, mImages[i].first,
+        mMouseIndex == (int)i ? 1.0 : 0.7);
+
+    nvgBeginPath(ctx);
+    nvgRoundedRect(ctx, p.x(), p.y(), mThumbSize, mThumbSize, 5);
+    nvgFillPaint(ctx, imgPaint);
+    nvgFill(ctx);
+
+    NVGpaint shadowPaint =
+        nvgBoxGradient(ctx, p.x() - 1, p.y(), mThumbSize + 2, mThumbSize + 2, 5, 3,
+                       nvgRGBA(0, 0, 0, 128), nvgRGBA(0, 0, 0, 0));
+    nvgBeginPath(ctx);
+    nvgRect(ctx, p.x()-5,p.y()-5, mThumbSize+10,mThumbSize+10);
+    nvgRoundedRect(ctx, p.x(),p.y(), mThumbSize,mThumbSize, 6);
+    nvgPathWinding(ctx, NVG_HOLE);
+    nvgFillPaint(ctx, shadowPaint);
+    nvgFill(ctx);
+
+    nvgBeginPath(ctx);
+    nvgRoundedRect(ctx, p.x()+0.5f,p.y()+0.5f, mThumbSize-1,mThumbSize-1, 4-0.5f);
+    nvgStrokeWidth(ctx, 1.0f);
+    nvgStrokeColor(ctx, nvgRGBA(255,255,255,80));
+    nvgStroke(ctx);
+}
+
+/* Signed distance of p to a rounded rectangle centered at the origin, same
+   as the NanoVG shaders use for box gradients */
+static float sdRoundRect(float px, float py, float ex, float ey, float radius) {
+    float dx = std::abs(px) - (ex - radius), dy = std::abs(py) - (ey - radius);
+    float ox = std::max(dx, 0.f), oy = std::max(dy, 0.f);
+    return std::min(std::max(dx, dy), 0.f) + std::sqrt(ox * ox + oy * oy) - radius;
+}
+
+ImagePanel::~ImagePanel() {
+    releaseAtlasPages();
+}
+
+void ImagePanel::releaseAtlasPages() {
+    if (mAtlasContext)
+        for (auto &page : mAtlasPages)
+            nvgDeleteImage(mAtlasContext, page.image);
+    mAtlasPages.clear();
+    mPruneThumbnails = true;
+}
+
+void ImagePanel::releaseThumbnails() {
+    /* Keep the pixels of resident pages only, the others are decoded again
+       once they are scrolled back into view */
+    size_t perPage = (size_t) mAtlasColumns * mAtlasRows;
+    for (size_t i = 0; i < mThumbnails.size(); ++i) {
+        if (mThumbnailState[i] != ThumbnailReady)
+            continue;
+        int pageIndex = perPage > 0 ? (int) (i / perPage) : -1;
+        bool resident = false;
+        for (auto &page : mAtlasPages)
+            resident = resident || page.index == pageIndex;
+        if (!resident) {
+            std::vector<uint8_t>().swap(mThumbnails[i]);
+            mThumbnailState[i] = ThumbnailNone;
+        }
+    }
+    mPruneThumbnails = false;
+}
+
+void ImagePanel::prepareAtlas(NVGcontext *ctx, int columns) {
+    Screen *scr = screen();
+    float ratio = scr ? scr->pixelRatio() : 1.f;
+    int thumbPx = (int) std::round(mThumbSize * ratio);
+    int stridePx = (int) std::round((mThumbSize + mSpacing) * ratio);
+
+    if (mAtlasReset || ctx != mAtlasContext || thumbPx != mAtlasThumbPx ||
+        stridePx != mAtlasStridePx) {
+        releaseAtlasPages();
+        mAtlasReset = false;
+        mAtlasContext = ctx;
+        mAtlasThumbPx = thumbPx;
+        mAtlasStridePx = stridePx;
+        mAtlasPadPx = (stridePx - thumbPx) / 2;
+        mAtlasColumns = 0;
+        /* Thumbnails in flight for the old image list are dropped on arrival */
+        mAtlasGeneration++;
+        mThumbnails.assign(mImages.size(), std::vector<uint8_t>());
+        mThumbnailState.assign(mImages.size(), ThumbnailNone);
+
+        /* Thumbnail and shadow shapes are the same for every cell, mirror
+           what drawImage() renders with paths */
+        float t = (float) mThumbSize;
+        mCellCoverage.resize((size_t) stridePx * stridePx);
+        mCellShadow.resize((size_t) stridePx * stridePx);
+        for (int y = 0; y < stridePx; ++y) {
+            for (int x = 0; x < stridePx; ++x) {
+                float lx = (x + 0.5f - mAtlasPadPx) / ratio;
+                float ly = (y + 0.5f - mAtlasPadPx) / ratio;
+                float thumb = sdRoundRect(lx - t * 0.5f, ly - t * 0.5f, t * 0.5f, t * 0.5f, 5.f);
+                float hole = sdRoundRect(lx - t * 0.5f, ly - t * 0.5f, t * 0.5f, t * 0.5f, 6.f);
+                float box = sdRoundRect(lx - t * 0.5f, ly - (t * 0.5f + 1.f),
+                                        t * 0.5f + 1.f, t * 0.5f + 1.f, 5.f);
+                float gradient = std::min(std::max((box + 1.5f) / 3.f, 0.f), 1.f);
+                float outside = std::min(std::max(0.5f + hole * ratio, 0.f), 1.f);
+                bool inRect = lx >= -5.f && ly >= -5.f && lx <= t + 5.f && ly <= t + 5.f;
+                size_t idx = (size_t) y * stridePx + x;
+                mCellCoverage[idx] = std::min(std::max(0.5f - thumb * ratio, 0.f), 1.f);
+                /* Pages are drawn with the idle opacity of 0.7, compensate so
+                   that the shadow keeps its strength */
+                mCellShadow[idx] = inRect ? std::min((128.f / 255.f) * (1.f - gradient) * outside / 0.7f, 1.f) : 0.f;
+            }
+        }
+    }
+
+    if (columns != mAtlasColumns) {
+        /* Pages mirror the grid, a different column count moves every cell */
+        releaseAtlasPages();
+        mAtlasColumns = columns;
+        mAtlasRows = std::max(1024 / mAtlasStridePx, 1);
+    }
+}
+
+void ImagePanel::requestThumbnails(NVGcontext *ctx, size_t first, size_t last) {
+    AsyncImageLoader *loader = nullptr;
+    for (size_t i = first; i < last; ++i) {
+        if (mThumbnailState[i] != ThumbnailNone)
+            continue;
+        if (mImages[i].second.empty()) {
+            mThumbnailState[i] = ThumbnailFailed;
+            continue;
+        }
+        if (!loader)
+            loader = &AsyncImageLoader::get(ctx);
+        mThumbnailState[i] = ThumbnailLoading;
+
+        ref<ImagePanel> self(this);
+        uint32_t generation = mAtlasGeneration;
+        loader->requestThumbnail(mImages[i].second, mAtlasThumbPx,
+            [self, generation, i](const AsyncImageLoader::Thumbnail &thumbnail) mutable {
+                ImagePanel *panel = self.get();
+                if (panel->mAtlasGeneration != generation || i >= panel->mThumbnails.size())
+                    return;
+                if (thumbnail.rgba.empty()) {
+                    panel->mThumbnailState[i] = ThumbnailFailed;
+                    return;
+                }
+                int pageIndex = (int) i / panel->mAtlasColumns / panel->mAtlasRows;
+                bool resident = false;
+                for (auto &page : panel->mAtlasPages) {
+                    if (page.index == pageIndex) {
+                        page.dirty = true;
+                        resident = true;
+                    }
+                }
+                /* Scrolled away meanwhile, it is requested again when needed */
+                if (!resident) {
+                    panel->mThumbnailState[i] = ThumbnailNone;
+                    return;
+                }
+                panel->mThumbnails[i] = thumbnail.rgba;
+                panel->mThumbnailState[i] = ThumbnailReady;
+            });
+    }
+}
 
-    for (size_t i=0; i<mImages.size(); ++i) {
-        Vector2i p = mPos + Vector2i::Constant(mMargin) +
-            Vector2i((int) i % grid.x(), (int) i / grid.x()) * (mThumbSize + mSpacing);
-        int imgw, imgh;
-
-        nvgImageSize(ctx, mImages[i].first, &imgw, &imgh);
-        float iw, ih, ix, iy;
-        if (imgw < imgh) {
-            iw = mThumbSize;
-            ih = iw * (float)imgh / (float)imgw;
-            ix = 0;
-            iy = -(ih - mThumbSize) * 0.5f;
+ImagePanel::AtlasPage &ImagePanel::atlasPage(NVGcontext *ctx, int index) {
+    AtlasPage *page = nullptr;
+    for (auto &candidate : mAtlasPages)
+        if (candidate.index == index)
+            page = &candidate;
+
+    if (!page) {
+        /* Reuse the least recently drawn page unless it is needed this frame */
+        AtlasPage *lru = nullptr;
+        for (auto &candidate : mAtlasPages)
+            if (candidate.lastUse != mAtlasFrame && (!lru || candidate.lastUse < lru->lastUse))
+                lru = &candidate;
+        if (lru && mAtlasPages.size() >= mMaxAtlasPages) {
+            page = lru;
+            mPruneThumbnails = true;
         } else {
-            ih = mThumbSize;
-            iw = ih * (float)imgw / (float)imgh;
-            ix = -(iw - mThumbSize) * 0.5f;
-            iy = 0;
+            mAtlasPages.push_back(AtlasPage());
+            page = &mAtlasPages.back();
+            page->image = nvgCreateImageRGBA(ctx, mAtlasColumns * mAtlasStridePx,
+                                             mAtlasRows * mAtlasStridePx, 0, nullptr);
         }
+        page->index = index;
+        page->dirty = true;
+    }
 
-        NVGpaint imgPaint = nvgImagePattern(
-            ctx, p.x() + ix, p.y()+ iy, iw, ih, 0, mImages[i].first,
-            mMouseIndex == (int)i ? 1.0 : 0.7);
+    if (page->dirty) {
+        bakeAtlasPage(ctx, *page);
+        page->dirty = false;
+    }
+    page->lastUse = mAtlasFrame;
+    return *page;
+}
 
-        nvgBeginPath(ctx);
-        nvgRoundedRect(ctx, p.x(), p.y(), mThumbSize, mThumbSize, 5);
-        nvgFillPaint(ctx, imgPaint);
-        nvgFill(ctx);
+void ImagePanel::bakeAtlasPage(NVGcontext *ctx, AtlasPage &page) {
+    int width = mAtlasColumns * mAtlasStridePx;
+    mAtlasPixels.assign((size_t) width * mAtlasRows * mAtlasStridePx * 4, 0);
+
+    size_t first = (size_t) page.index * mAtlasRows * mAtlasColumns;
+    size_t last = std::min(first + (size_t) mAtlasRows * mAtlasColumns, mImages.size());
+    for (size_t i = first; i < last; ++i) {
+        if (mThumbnailState[i] != ThumbnailReady)
+            continue;
+        const uint8_t *thumb = mThumbnails[i].data();
+        int cx = (int) ((i - first) % mAtlasColumns) * mAtlasStridePx;
+        int cy = (int) ((i - first) / mAtlasColumns) * mAtlasStridePx;
+        for (int y = 0; y < mAtlasStridePx; ++y) {
+            uint8_t *out = mAtlasPixels.data() + ((size_t) (cy + y) * width + cx) * 4;
+            int ty = y - mAtlasPadPx;
+            for (int x = 0; x < mAtlasStridePx; ++x, out += 4) {
+                size_t idx = (size_t) y * mAtlasStridePx + x;
+                int tx = x - mAtlasPadPx;
+                float alpha = 0.f;
+                const uint8_t *src = nullptr;
+                if (tx >= 0 && ty >= 0 && tx < mAtlasThumbPx && ty < mAtlasThumbPx) {
+                    src = thumb + ((size_t) ty * mAtlasThumbPx + tx) * 4;
+                    alpha = mCellCoverage[idx] * src[3] / 255.f;
+                }
+                /* Thumbnail over its (black) shadow */
+                float total = alpha + mCellShadow[idx] * (1.f - alpha);
+                if (total <= 0.f)
+                    continue;
+                for (int c = 0; c < 3; ++c)
+                    out[c] = src ? (uint8_t) (src[c] * alpha / total + 0.5f) : 0;
+                out[3] = (uint8_t) (total * 255.f + 0.5f);
+            }
+        }
+    }
+    nvgUpdateImage(ctx, page.image, mAtlasPixels.data());
+}
+
+void ImagePanel::draw(NVGcontext* ctx) {
+    if (mImages.empty())
+        return;
+    Vector2i grid = gridSize();
+
+    /* Swap in images from loadImageDirectoryAsync() once they are uploaded */
+    if (AsyncImageLoader *loader = AsyncImageLoader::find(ctx)) {
+        int placeholder = loader->placeholder();
+        for (auto &image : mImages)
+            if (image.first == placeholder)
+                image.first = loader->request(image.second);
+    }
+
+    /* Skip rows that are clipped away, e.g. by a surrounding scroll panel */
+    Vector4i visible = visibleRect();
+    if (visible.z() <= visible.x())
+        return;
+    int stride = mThumbSize + mSpacing;
+    int firstRow = std::max((visible.y() - mPos.y() - mMargin) / stride, 0);
+    int lastRow = std::min((visible.w() - mPos.y() - mMargin) / stride, grid.y() - 1);
+    if (lastRow < firstRow)
+        return;
+    size_t first = (size_t) firstRow * grid.x();
+    size_t last = std::min((size_t) (lastRow + 1) * grid.x(), mImages.size());
+
+    if (mUseAtlas) {
+        prepareAtlas(ctx, grid.x());
+        requestThumbnails(ctx, first, last);
+    }
+
+    /* Images without an atlas thumbnail (yet) are drawn one by one */
+    for (size_t i = first; i < last; ++i)
+        if (!mUseAtlas || mThumbnailState[i] != ThumbnailReady)
+            drawImage(ctx, i, cellPosition(i, grid));
+
+    if (!mUseAtlas)
+        return;
+
+    /* A page is laid out like the grid, so one pattern and a single
+       rectangle draw all of its thumbnails including their shadows */
+    mAtlasFrame++;
+    float pad = mAtlasPadPx * mThumbSize / (float) mAtlasThumbPx;
+    float pageWidth = (float) mAtlasColumns * stride, pageHeight = (float) mAtlasRows * stride;
+    float originX = mPos.x() + mMargin - pad, originY = mPos.y() + mMargin - pad;
+    for (int index = firstRow / mAtlasRows; index <= lastRow / mAtlasRows; ++index) {
+        const AtlasPage &page = atlasPage(ctx, index);
+        float pageY = originY + index * pageHeight;
+        int rowBegin = std::max(firstRow, index * mAtlasRows);
+        int rowEnd = std::min(lastRow + 1, (index + 1) * mAtlasRows);
 
-        NVGpaint shadowPaint =
-            nvgBoxGradient(ctx, p.x() - 1, p.y(), mThumbSize + 2, mThumbSize + 2, 5, 3,
-                           nvgRGBA(0, 0, 0, 128), nvgRGBA(0, 0, 0, 0));
         nvgBeginPath(ctx);
-        nvgRect(ctx, p.x()-5,p.y()-5, mThumbSize+10,mThumbSize+10);
-        nvgRoundedRect(ctx, p.x(),p.y(), mThumbSize,mThumbSize, 6);
-        nvgPathWinding(ctx, NVG_HOLE);
-        nvgFillPaint(ctx, shadowPaint);
+        nvgRect(ctx, originX, originY + rowBegin * stride, pageWidth, (rowEnd - rowBegin) * stride);
+        nvgFillPaint(ctx, nvgImagePattern(ctx, originX, pageY, pageWidth, pageHeight,
+                                          0, page.image, 0.7f));
         nvgFill(ctx);
 
-        nvgBeginPath(ctx);
+        int rowOfMouse = mMouseIndex >= 0 ? mMouseIndex / grid.x() : -1;
+        if (rowOfMouse >= rowBegin && rowOfMouse < rowEnd && mMouseIndex < (int) mImages.size() &&
+            mThumbnailState[mMouseIndex] == ThumbnailReady) {
+            Vector2i p = cellPosition(mMouseIndex, grid);
+            nvgBeginPath(ctx);
+            nvgRoundedRect(ctx, p.x(), p.y(), mThumbSize, mThumbSize, 5);
+            nvgFillPaint(ctx, nvgImagePattern(ctx, originX, pageY, pageWidth, pageHeight,
+                                              0, page.image, 1.0f));
+            nvgFill(ctx);
+        }
+    }
+
+    nvgBeginPath(ctx);
+    for (size_t i = first; i < last; ++i) {
+        if (mThumbnailState[i] != ThumbnailReady)
+            continue;
+        Vector2i p = cellPosition(i, grid);
         nvgRoundedRect(ctx, p.x()+0.5f,p.y()+0.5f, mThumbSize-1,mThumbSize-1, 4-0.5f);
-        nvgStrokeWidth(ctx, 1.0f);
-        nvgStrokeColor(ctx, nvgRGBA(255,255,255,80));
-        nvgStroke(ctx);
     }
+    nvgStrokeWidth(ctx, 1.0f);
+    nvgStrokeColor(ctx, nvgRGBA(255,255,255,80));
+    nvgStroke(ctx);
+
+    if (mPruneThumbnails)
+        releaseThumbnails();
 }
 
 NAMESPACE_END(nanogui)
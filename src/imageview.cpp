@@ -15,8 +15,11 @@
 #include <nanogui/window.h>
 #include <nanogui/screen.h>
 #include <nanogui/theme.h>
+#include <nanogui/imageloader.h>
 #include <nanovg.h>
 #include <cmath>
+#include <cstdio>
+#include <algorithm>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -28,15 +31,195 @@ ImageView::ImageView(Widget* parent, uint32_t imageID)
     updateImageParameters();
 }
 
-ImageView::~ImageView() {}
+ImageView::~ImageView() {
+    if (mOwnedImage)
+        nvgDeleteImage(mOwnedImageContext, mOwnedImage);
+    releaseTiles();
+}
 
 void ImageView::bindImage(uint32_t imageId) {
+    releaseTiles();
+    mTileSource = nullptr;
     mImageID = imageId;
     updateImageParameters();
     fit();
 }
 
+void ImageView::setImageData(int width, int height, const uint8_t *rgba) {
+    Screen *scr = screen();
+    if (!scr)
+        throw std::runtime_error("ImageView::setImageData(): widget is not part of a screen");
+    NVGcontext *ctx = scr->nvgContext();
+
+    if (mOwnedImage && mOwnedImageContext == ctx && (uint32_t) mOwnedImage == mImageID &&
+        mImageSize == Vector2i(width, height)) {
+        nvgUpdateImage(ctx, mOwnedImage, rgba);
+        invalidatePixelInfo();
+        return;
+    }
+
+    int image = nvgCreateImageRGBA(ctx, width, height, 0, rgba);
+    if (image == 0)
+        throw std::runtime_error("ImageView::setImageData(): could not create image");
+    if (mOwnedImage)
+        nvgDeleteImage(mOwnedImageContext, mOwnedImage);
+    mOwnedImage = image;
+    mOwnedImageContext = ctx;
+    bindImage(image);
+}
+
+void ImageView::setTileSource(TileSource *source) {
+    releaseTiles();
+    mTileSource = source;
+    updateImageParameters();
+    fit();
+}
+
+void ImageView::releaseTiles() {
+    if (!mTileContext)
+        return;
+    if (AsyncImageLoader *loader = AsyncImageLoader::find(mTileContext))
+        for (auto &pending : mPendingTiles)
+            loader->cancel(pending.second);
+    for (auto &tile : mTiles)
+        nvgDeleteImage(mTileContext, tile.image);
+    mPendingTiles.clear();
+    mTiles.clear();
+    mTileIndex.clear();
+}
+
+static inline uint64_t tileKey(int level, int x, int y) {
+    return ((uint64_t) level << 56) | ((uint64_t) y << 28) | (uint64_t) x;
+}
+
+int ImageView::tileImage(uint64_t key) {
+    auto it = mTileIndex.find(key);
+    if (it == mTileIndex.end())
+        return 0;
+    mTiles.splice(mTiles.begin(), mTiles, it->second);
+    it->second->lastUse = mTileFrame;
+    return it->second->image;
+}
+
+void ImageView::requestTile(int level, int x, int y) {
+    uint64_t key = tileKey(level, x, y);
+    if (mTileIndex.count(key) || mPendingTiles.count(key))
+        return;
+
+    ref<TileSource> source = mTileSource;
+    ref<ImageView> self(this);
+    uint64_t ticket = AsyncImageLoader::get(mTileContext).requestPixels(
+        [source, level, x, y](std::vector<uint8_t> &rgba, int &width, int &height) mutable {
+            width = height = source->tileSize();
+            rgba.resize((size_t) width * height * 4);
+            return source->readTile(level, x, y, rgba.data());
+        },
+        [self, key](int image) mutable {
+            ImageView *view = self.get();
+            view->mPendingTiles.erase(key);
+            if (!image)
+                return;
+            view->mTiles.push_front(Tile { key, image, view->mTileFrame });
+            view->mTileIndex[key] = view->mTiles.begin();
+        },
+        /* Level 0 is the one shown zoomed in, keep its pixels sharp and
+           its tile edges free of seams */
+        level == 0 ? NVG_IMAGE_NEAREST : 0);
+    mPendingTiles[key] = ticket;
+}
+
+void ImageView::drawTiles(NVGcontext* ctx) {
+    if (ctx != mTileContext) {
+        releaseTiles();
+        mTileContext = ctx;
+    }
+    TileSource *source = mTileSource;
+    Screen *scr = screen();
+    float ratio = scr ? scr->pixelRatio() : 1.f;
+
+    /* Coarsest level that still has at least one texel per screen pixel */
+    int level = 0;
+    float density = mScale * ratio;
+    while (level + 1 < source->levelCount() && density * (1 << (level + 1)) <= 1.f)
+        level++;
+
+    /* Visible tiles, extended by one tile in every direction for prefetching */
+    int tileSize = source->tileSize();
+    float extent = (float) (tileSize << level);
+    Vector2i count = source->tileCount(level);
+    Vector2f lo = clampedImageCoordinateAt(Vector2f::Zero());
+    Vector2f hi = clampedImageCoordinateAt(sizeF());
+    int x0 = (int) (lo.x() / extent), y0 = (int) (lo.y() / extent);
+    int x1 = std::min((int) std::ceil(hi.x() / extent), count.x());
+    int y1 = std::min((int) std::ceil(hi.y() / extent), count.y());
+    int px0 = std::max(x0 - 1, 0), py0 = std::max(y0 - 1, 0);
+    int px1 = std::min(x1 + 1, count.x()), py1 = std::min(y1 + 1, count.y());
+
+    mTileFrame++;
+    Vector2f origin = positionF();
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            int drawLevel = level, image = tileImage(tileKey(level, x, y));
+            if (!image) {
+                requestTile(level, x, y);
+                while (!image && ++drawLevel < source->levelCount())
+                    image = tileImage(tileKey(drawLevel, x >> (drawLevel - level),
+                                              y >> (drawLevel - level)));
+                if (!image)
+                    continue;
+            }
+
+            /* The pattern spans the whole (possibly coarser) tile, the path
+               only covers the part of the image belonging to this tile */
+            int shift = drawLevel - level;
+            float drawExtent = (float) (tileSize << drawLevel);
+            Vector2f patternPos = origin + positionForCoordinate(
+                Vector2f((x >> shift) * drawExtent, (y >> shift) * drawExtent));
+            Vector2f tileLo = origin + positionForCoordinate(Vector2f(x * extent, y * extent));
+            Vector2f tileHi = origin + positionForCoordinate(
+                Vector2f(std::min((x + 1) * extent, (float) mImageSize.x()),
+                         std::min((y + 1) * extent, (float) mImageSize.y())));
+
+            nvgBeginPath(ctx);
+            nvgRect(ctx, tileLo.x(), tileLo.y(), tileHi.x() - tileLo.x(), tileHi.y() - tileLo.y());
+            nvgFillPaint(ctx, nvgImagePattern(ctx, patternPos.x(), patternPos.y(),
+                                              drawExtent * mScale, drawExtent * mScale,
+                                              0, image, 1.0f));
+            nvgFill(ctx);
+        }
+    }
+
+    for (int y = py0; y < py1; ++y)
+        for (int x = px0; x < px1; ++x)
+            if (x < x0 || x >= x1 || y < y0 || y >= y1)
+                requestTile(level, x, y);
+
+    /* Tiles that scrolled away before they were loaded are not needed anymore */
+    AsyncImageLoader *loader = AsyncImageLoader::find(ctx);
+    for (auto it = mPendingTiles.begin(); it != mPendingTiles.end(); ) {
+        int l = (int) (it->first >> 56), y = (int) ((it->first >> 28) & 0xfffffff),
+            x = (int) (it->first & 0xfffffff);
+        if (l != level || x < px0 || x >= px1 || y < py0 || y >= py1) {
+            if (loader)
+                loader->cancel(it->second);
+            it = mPendingTiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    while (mTiles.size() > mTileCacheCapacity && mTiles.back().lastUse != mTileFrame) {
+        nvgDeleteImage(ctx, mTiles.back().image);
+        mTileIndex.erase(mTiles.back().key);
+        mTiles.pop_back();
+    }
+}
+
 void ImageView::updateImageParameters() {
+    if (mTileSource) {
+        mImageSize = mTileSource->size();
+        return;
+    }
     int32_t w, h;
     nvgImageSize(screen()->nvgContext(), mImageID, &w, &h);
     mImageSize = Vector2i(w, h);
@@ -44,6 +227,11 @@ void ImageView::updateImageParameters() {
 
 void ImageView::_internalDraw(NVGcontext* ctx)
 {
+    if (mTileSource) {
+        drawTiles(ctx);
+        return;
+    }
+
     Vector2f scaleFactor(mScale, mScale);
     Vector2f positionInScreen = position().cast<float>();
     Vector2f positionAfterOffset = positionInScreen + mOffset;
@@ -136,7 +324,8 @@ bool ImageView::gridVisible() const {
 }
 
 bool ImageView::pixelInfoVisible() const {
-    return mPixelInfoCallback && (mPixelInfoThreshold != -1) && (mScale > mPixelInfoThreshold);
+    return (mPixelInfoCallback || mPixelInfoRegionCallback) && (mPixelInfoThreshold != -1) &&
+           (mScale > mPixelInfoThreshold);
 }
 
 bool ImageView::helpersVisible() const {
@@ -339,12 +528,12 @@ void ImageView::drawPixelInfo(NVGcontext* ctx, float stride) const {
                                .unaryExpr([](float x) { return std::ceil(x); })
                                .cast<int>();
 
-    // Extract the positions for where to draw the text.
-    Vector2f currentCellPosition =
-        (positionF() + positionForCoordinate(topLeft.cast<float>()));
+    Vector2i size = (bottomRight - topLeft).cwiseMax(Vector2i::Zero());
+    updatePixelInfo(topLeft, size);
+    const PixelInfoCache &cache = mPixelInfoCache;
 
-    float xInitialPosition = currentCellPosition.x();
-    int xInitialIndex = topLeft.x();
+    // Extract the positions for where to draw the text.
+    Vector2f origin = positionF() + positionForCoordinate(topLeft.cast<float>());
 
     // Properly scale the pixel information for the given stride.
     auto fontSize = stride * mFontScaleFactor;
@@ -353,59 +542,96 @@ void ImageView::drawPixelInfo(NVGcontext* ctx, float stride) const {
     nvgBeginPath(ctx);
     nvgFontSize(ctx, fontSize);
     nvgTextAlign(ctx, NVG_ALIGN_CENTER | NVG_ALIGN_TOP);
-    nvgFontFace(ctx, "sans");
-    while (topLeft.y() != bottomRight.y()) {
-        while (topLeft.x() != bottomRight.x()) {
-            writePixelInfo(ctx, currentCellPosition, topLeft, stride, fontSize);
-            currentCellPosition.x() += stride;
-            ++topLeft.x();
+    nvgFontFaceId(ctx, mTheme->mFontNormal);
+    for (int y = 0; y < size.y(); ++y) {
+        for (int x = 0; x < size.x(); ++x) {
+            int i = y * size.x() + x;
+            uint32_t first = cache.firstLine[i], count = cache.firstLine[i + 1] - first;
+            // If no data is provided for this pixel then simply skip it.
+            if (count == 0)
+                continue;
+            nvgFillColor(ctx, cache.colors[i]);
+            float cx = origin.x() + x * stride + stride / 2;
+            float cy = origin.y() + y * stride + (stride - fontSize * count) / 2;
+            for (uint32_t l = 0; l < count; ++l) {
+                const auto &line = cache.lines[first + l];
+                nvgText(ctx, cx, cy, cache.text.data() + line.first,
+                        cache.text.data() + line.second);
+                cy += fontSize;
+            }
         }
-        currentCellPosition.x() = xInitialPosition;
-        currentCellPosition.y() += stride;
-        ++topLeft.y();
-        topLeft.x() = xInitialIndex;
     }
 }
 
-namespace
-{
-  std::vector<std::string> tokenize(const std::string &string,
-    const std::string &delim = "\n",
-    bool includeEmpty = false) {
-    std::string::size_type lastPos = 0, pos = string.find_first_of(delim, lastPos);
-    std::vector<std::string> tokens;
-
-    while (lastPos != std::string::npos) {
-      std::string substr = string.substr(lastPos, pos - lastPos);
-      if (!substr.empty() || includeEmpty)
-        tokens.push_back(std::move(substr));
-      lastPos = pos;
-      if (lastPos != std::string::npos) {
-        lastPos += 1;
-        pos = string.find_first_of(delim, lastPos);
-      }
-    }
-
-    return tokens;
-  }
-}
-
-void ImageView::writePixelInfo(NVGcontext* ctx, const Vector2f& cellPosition,
-                               const Vector2i& pixel, float stride, float fontSize) const {
-    auto pixelData = mPixelInfoCallback(pixel);
-    auto pixelDataRows = tokenize(pixelData.first);
-
-    // If no data is provided for this pixel then simply return.
-    if (pixelDataRows.empty())
+void ImageView::updatePixelInfo(const Vector2i& origin, const Vector2i& size) const {
+    PixelInfoCache &cache = mPixelInfoCache;
+    if (cache.valid && cache.origin == origin && cache.size == size &&
+        cache.image == mImageID && cache.tiles == mTileSource.get())
         return;
 
-    nvgFillColor(ctx, pixelData.second);
-    float yOffset = (stride - fontSize * pixelDataRows.size()) / 2;
-    for (size_t i = 0; i != pixelDataRows.size(); ++i) {
-        nvgText(ctx, cellPosition.x() + stride / 2, cellPosition.y() + yOffset,
-                pixelDataRows[i].data(), nullptr);
-        yOffset += fontSize;
+    cache.valid = true;
+    cache.origin = origin;
+    cache.size = size;
+    cache.image = mImageID;
+    cache.tiles = mTileSource.get();
+    // Buffers keep their capacity, so panning at a fixed zoom doesn't allocate
+    cache.text.clear();
+    cache.lines.clear();
+    cache.firstLine.clear();
+    cache.colors.clear();
+
+    auto addLine = [&cache](const char *begin, const char *end) {
+        uint32_t offset = (uint32_t) cache.text.size();
+        cache.text.append(begin, end);
+        cache.lines.emplace_back(offset, (uint32_t) cache.text.size());
+    };
+
+    size_t count = (size_t) size.x() * size.y();
+    if (mPixelInfoRegionCallback) {
+        PixelInfoRegion &region = mPixelInfoRegion;
+        region.origin = origin;
+        region.size = size;
+        region.channels = 4;
+        region.precision = 3;
+        region.values.assign(count * 4, 0.f);
+        region.colors.assign(count, mTheme->mTextColor);
+        mPixelInfoRegionCallback(region);
+
+        int channels = std::min(std::max(region.channels, 0), 4);
+        char buf[64];
+        for (size_t i = 0; i < count; ++i) {
+            cache.firstLine.push_back((uint32_t) cache.lines.size());
+            cache.colors.push_back(i < region.colors.size() ? region.colors[i] : mTheme->mTextColor);
+            for (int c = 0; c < channels && i * 4 + c < region.values.size(); ++c) {
+                float value = region.values[i * 4 + c];
+                if (std::isnan(value))
+                    continue;
+                int length = std::snprintf(buf, sizeof(buf), "%.*f", region.precision, value);
+                if (length > 0)
+                    addLine(buf, buf + std::min(length, (int) sizeof(buf) - 1));
+            }
+        }
+    } else {
+        for (int y = 0; y < size.y(); ++y) {
+            for (int x = 0; x < size.x(); ++x) {
+                auto pixelData = mPixelInfoCallback(origin + Vector2i(x, y));
+                cache.firstLine.push_back((uint32_t) cache.lines.size());
+                cache.colors.push_back(pixelData.second);
+                // One line per non-empty row of the returned text
+                const std::string &str = pixelData.first;
+                size_t pos = 0;
+                while (pos <= str.size()) {
+                    size_t next = str.find('\n', pos);
+                    if (next == std::string::npos)
+                        next = str.size();
+                    if (next > pos)
+                        addLine(str.data() + pos, str.data() + next);
+                    pos = next + 1;
+                }
+            }
+        }
     }
+    cache.firstLine.push_back((uint32_t) cache.lines.size());
 }
 
 NAMESPACE_END(nanogui)
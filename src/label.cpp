@@ -11,6 +11,8 @@
 
 #include <nanogui/label.h>
 #include <nanogui/theme.h>
+#include <nanogui/textcache.h>
+#include <nanogui/fontregistry.h>
 #include <nanovg.h>
 #include <nanogui/serializer/core.h>
 
@@ -33,6 +35,12 @@ void Label::setTheme(Theme *theme) {
     }
 }
 
+int Label::fontHandle(NVGcontext *ctx) const {
+    if (mFontHandle == -1)
+        mFontHandle = FontRegistry::get(ctx).resolve(mFont);
+    return mFontHandle;
+}
+
 Vector2i Label::preferredSize(NVGcontext *ctx) const {
   if (mCaption == "")
   {
@@ -41,18 +49,14 @@ Vector2i Label::preferredSize(NVGcontext *ctx) const {
 
     return Vector2i::Zero();
   }
-  nvgFontFace(ctx, mFont.c_str());
-  nvgFontSize(ctx, fontSize());
+  const TextRun &run = TextLayoutCache::get(ctx).measure(
+      fontHandle(ctx), fontSize(), NVG_ALIGN_LEFT | NVG_ALIGN_TOP, mCaption);
   if (mFixedSize.x() > 0 || mFixedSize.y() > 0) {
-      float bounds[4];
-      nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
-      nvgTextBounds(ctx, 0, 0, mCaption.c_str(), nullptr, bounds);
-      const_cast<Label*>(this)->mTextRealSize = Vector2i(bounds[2] - bounds[0], bounds[3] - bounds[1] );
+      const_cast<Label*>(this)->mTextRealSize = Vector2i(run.bounds[2] - run.bounds[0], run.bounds[3] - run.bounds[1] );
       return Vector2i(mFixedSize.x() > 0 ? mFixedSize.x() : mTextRealSize.x(),
                       mFixedSize.y() > 0 ? mFixedSize.y() : mTextRealSize.y());
   } else {
-      nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
-      int tw = nvgTextBounds(ctx, 0, 0, mCaption.c_str(), nullptr, nullptr) + 2;
+      int tw = run.advance + 2;
       int th = fontSize();
       const_cast<Label*>(this)->mTextRealSize = Vector2i(tw, th);
       return Vector2i( std::max(mMinSize.x(), tw), std::max(mMinSize.y(),th) );
@@ -61,8 +65,6 @@ Vector2i Label::preferredSize(NVGcontext *ctx) const {
 
 void Label::draw(NVGcontext *ctx) {
     Widget::draw(ctx);
-    nvgFontFace(ctx, mFont.c_str());
-    nvgFontSize(ctx, fontSize());
     Color color;
     if (enabled()) color = (mColor.w() > 0) ? mColor : mTheme->mTextColor;
     else color = (mDisabledColor.w() > 0) ? mDisabledColor : mTheme->mLabelTextDisabledColor;
@@ -85,9 +87,12 @@ void Label::draw(NVGcontext *ctx) {
     case TextVAlign::vBottom: ypos = (mSize.y() - mTextRealSize.y()); break;
     }
 
-    nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
+    /* Line breaking is cached along with the measurements */
+    auto &cache = TextLayoutCache::get(ctx);
+    const TextRun &run = cache.measure(fontHandle(ctx), fontSize(), NVG_ALIGN_LEFT | NVG_ALIGN_TOP,
+                                       mCaption, std::max(mFixedSize.x(), 0));
     if (mFixedSize.x() > 0)
-      nvgTextBox(ctx, mPos.x() + xpos, mPos.y() + ypos, mFixedSize.x(), mCaption.c_str(), nullptr);
+      cache.drawBox(mPos.x() + xpos, mPos.y() + ypos, run, mCaption);
     else
       nvgText(ctx, mPos.x() + xpos, mPos.y() + ypos, mCaption.c_str(), nullptr);
 }
@@ -103,6 +108,7 @@ bool Label::load(Serializer &s) {
     if (!Widget::load(s)) return false;
     if (!s.get("caption", mCaption)) return false;
     if (!s.get("font", mFont)) return false;
+    mFontHandle = -1;
     if (!s.get("color", mColor)) return false;
     return true;
 }
@@ -1,5 +1,6 @@
 #include <nanogui/ledmatrix.h>
 #include <nanovg.h>
+#include <algorithm>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -30,6 +31,19 @@ void LedMatrix::setColorAt(int row, int col, const Color& rgb)
     colorTable[col][row] = rgb.toInt();
 }
 
+void LedMatrix::setColors(const uint32_t* colors, int rows, int columns, size_t rowStride)
+{
+  mCacheDirty = true;
+  rows = std::min(rows, mRowCount);
+  columns = std::min(columns, mColumnCount);
+  for (int col = 0; col < columns; ++col)
+  {
+    auto& column = colorTable[col];
+    for (int row = 0; row < rows; ++row)
+      column[row] = (int)colors[row * rowStride + col];
+  }
+}
+
 void LedMatrix::performLayout(NVGcontext* ctx)
 {
   Widget::performLayout(ctx);
@@ -4,6 +4,7 @@
 #include <nanogui/button.h>
 #include <nanogui/layout.h>
 #include <nanovg.h>
+#include <algorithm>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -70,7 +71,7 @@ void ListboxItem::draw(NVGcontext *ctx)
 
   int fontSize = mFontSize == -1 ? mTheme->mButtonFontSize : mFontSize;
   nvgFontSize(ctx, fontSize);
-  nvgFontFace(ctx, "sans-bold");
+  nvgFontFaceId(ctx, mTheme->mFontBold);
   float tw = nvgTextBounds(ctx, 0, 0, mCaption.c_str(), nullptr, nullptr);
 
   Vector2f center = mPos.cast<float>() + mSize.cast<float>() * 0.5f;
@@ -85,7 +86,7 @@ void ListboxItem::draw(NVGcontext *ctx)
     if (nvgIsFontIcon(mIcon)) {
       ih *= icon_scale();
       nvgFontSize(ctx, ih);
-      nvgFontFace(ctx, "icons");
+      nvgFontFaceId(ctx, mTheme->mFontIcons);
       iw = nvgTextBounds(ctx, 0, 0, icon.data(), nullptr, nullptr);
     }
     else {
@@ -129,7 +130,7 @@ void ListboxItem::draw(NVGcontext *ctx)
   }
 
   nvgFontSize(ctx, fontSize);
-  nvgFontFace(ctx, "sans-bold");
+  nvgFontFaceId(ctx, mTheme->mFontBold);
   nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
   nvgFillColor(ctx, mTheme->mTextColorShadow);
   nvgText(ctx, textPos.x(), textPos.y(), mCaption.c_str(), nullptr);
@@ -137,24 +138,106 @@ void ListboxItem::draw(NVGcontext *ctx)
   nvgText(ctx, textPos.x(), textPos.y() + 1, mCaption.c_str(), nullptr);
 }
 
-class WidgetsArea : public Widget
+/* Keeps a pool of rows covering the visible part of the list and binds
+   them to the entries under the viewport */
+class ListboxRows : public Widget
 {
 public:
-  WidgetsArea(Widget* parent) : Widget(parent) {}
+  ListboxRows(Widget* parent, Listbox* owner) : Widget(parent), mOwner(owner) {}
+
+  Vector2i preferredSize(NVGcontext *) const override
+  {
+    return Vector2i(parent()->width(), mOwner->mItemCount * rowHeight());
+  }
+
   void performLayout(NVGcontext *ctx) override
   {
     VScrollPanel* vpanel = parent()->cast<VScrollPanel>();
     int xoffset = 0;
-    if (vpanel)
+    if (vpanel && vpanel->isSliderVisible())
       xoffset = vpanel->getSliderAreaWidth();
-    setSize(parent()->size() - Vector2i(xoffset, 0));
+    setWidth(parent()->width() - xoffset);
+
+    if (childCount() == 0)
+      new ListboxItem(this, "");
+    if (mMeasuredHeight == 0)
+      mMeasuredHeight = std::max(mChildren[0]->preferredSize(ctx).y(), 1);
+
+    int h = rowHeight();
+    int rows = parent()->height() / h + 2;
+    while (childCount() < rows)
+      new ListboxItem(this, "");
+    while (childCount() > rows)
+      removeChild(childCount() - 1);
+
     Widget::performLayout(ctx);
+    mFirst = -1;
+    bindRows();
   }
 
   void draw(NVGcontext* ctx) override
   {
+    bindRows();
     Widget::draw(ctx);
   }
+
+  /* The rows are positioned by hand, not by a layout */
+  void bindRows()
+  {
+    int h = rowHeight();
+    int first = std::max(-mPos.y() / h, 0);
+    if (first == mFirst && mBoundCount == mOwner->mItemCount)
+      return;
+    mFirst = first;
+    mBoundCount = mOwner->mItemCount;
+
+    for (int k = 0; k < childCount(); ++k)
+    {
+      ListboxItem* row = (ListboxItem*) mChildren[k];
+      int index = first + k;
+      if (index >= mOwner->mItemCount)
+      {
+        row->setVisible(false);
+        row->setIndex(-1);
+        continue;
+      }
+      row->setVisible(true);
+      row->setPosition(Vector2i(0, index * h));
+      row->setSize(Vector2i(width(), h));
+      if (row->index() == index)
+        continue;
+      row->setIndex(index);
+      row->setPushed(false);
+      if (mOwner->mBind)
+        mOwner->mBind(index, row);
+      else
+      {
+        row->setCaption(mOwner->mEntries[index].caption);
+        row->setId(mOwner->mEntries[index].id);
+      }
+    }
+  }
+
+  /* Forget the bindings, e.g. when the entries changed */
+  void invalidate()
+  {
+    mFirst = -1;
+    for (auto child : mChildren)
+      ((ListboxItem*) child)->setIndex(-1);
+  }
+
+  int rowHeight() const
+  {
+    if (mOwner->mRowHeight > 0)
+      return mOwner->mRowHeight;
+    return mMeasuredHeight > 0 ? mMeasuredHeight : 24;
+  }
+
+private:
+  Listbox* mOwner;
+  int mFirst = -1;
+  int mBoundCount = 0;
+  int mMeasuredHeight = 0;
 };
 
 Vector2i Listbox::preferredSize(NVGcontext * /* ctx */) const {
@@ -170,8 +253,7 @@ Listbox::Listbox(Widget* parent)
   : Widget(parent)
 {
   mPanel = add<VScrollPanel>();
-  mItems = mPanel->add<WidgetsArea>();
-  mItems->boxlayout(Orientation::Vertical, Alignment::Minimum);
+  mItems = new ListboxRows(mPanel, this);
 }
 
 void Listbox::selectItem(ListboxItem* item)
@@ -201,9 +283,43 @@ void Listbox::addItem(const std::string& str, const std::string& id)
   if (!mPanel)
     return;
 
-  auto& i = mItems->wdg<ListboxItem>(str);
-  i.setId(id);
+  /* No widget per entry, rows are bound to entries while drawing */
+  mEntries.push_back({ str, id });
+  mItemCount = (int) mEntries.size();
+  if (mBind)
+  {
+    /* Rows still show what the setItemCount() model bound */
+    mBind = nullptr;
+    ((ListboxRows*) mItems)->invalidate();
+  }
+}
 
+void Listbox::setItemCount(int count, const BindRow &bind)
+{
+  mEntries.clear();
+  mBind = bind;
+  mItemCount = std::max(count, 0);
+  ((ListboxRows*) mItems)->invalidate();
+}
+
+void Listbox::clear()
+{
+  mEntries.clear();
+  mBind = nullptr;
+  mItemCount = 0;
+  mPanel->setScroll(0.f);
+  ((ListboxRows*) mItems)->invalidate();
+}
+
+void Listbox::scrollToItem(int index)
+{
+  /* Rows have a fixed height, so the offset is known without a layout */
+  int h = ((ListboxRows*) mItems)->rowHeight();
+  int range = mItemCount * h - mPanel->height();
+  if (range <= 0)
+    return;
+  index = std::max(0, std::min(index, mItemCount - 1));
+  mPanel->setScroll(std::min(index * h / (float) range, 1.f));
 }
 
 void Listbox::performLayout(NVGcontext *ctx) {
@@ -3,6 +3,7 @@
 #include <math.h>
 #include <nanovg.h>
 #include <string>
+#include <vector>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -67,6 +68,7 @@ void Meter::setValue(int value)
 void Meter::setMinValue(double value)
 {
    m_minValue=value;
+   invalidateFace();
 }
 
 void Meter::setMinValue(int value)
@@ -79,6 +81,7 @@ void Meter::setMaxValue(double value)
   if (value > m_minValue)
   {
       m_maxValue=value;
+      invalidateFace();
   }
   else
   {
@@ -98,6 +101,7 @@ void Meter::setThreshold(double value)
   if (value > m_minValue && value < m_maxValue)
   {
       m_threshold=value;
+      invalidateFace();
   }
   else
   {
@@ -140,6 +144,7 @@ void Meter::draw(NVGcontext *ctx)
     thresholdManager();
 
     nvgSave(ctx);
+    updateFace(ctx);
 
     drawBackground(ctx);
     drawCoverGlass(ctx);
@@ -160,16 +165,19 @@ void Meter::draw(NVGcontext *ctx)
 void Meter::setSteps(int nSteps)
 {
   m_steps=nSteps;
+  invalidateFace();
 }
 
 void Meter::setStartAngle(double value)
 {
   m_startAngle=value;
+  invalidateFace();
 }
 
 void Meter::setEndAngle(double value)
 {
   m_endAngle=value;
+  invalidateFace();
 }
 
 void Meter::setForeground(const Color& newForeColor)
@@ -287,28 +295,63 @@ void Meter::drawBackground(NVGcontext *ctx)
   nvgFill(ctx);
 }
 
-void Meter::drawTicks(NVGcontext *ctx)
+void Meter::updateFace(NVGcontext *ctx)
 {
-  nvgBeginPath(ctx);
-  int nSteps=m_steps;
-  Vector2i center = mPos + mSize / 2;
-  double angleStep=(m_endAngle-m_startAngle)/m_steps;
+  float fsize = fontSize();
+  if (mFace.valid && mFace.size == mSize && mFace.fontSize == fsize)
+    return;
+
+  mFace.valid = true;
+  mFace.size = mSize;
+  mFace.fontSize = fsize;
+
+  double angleStep = (m_endAngle - m_startAngle) / m_steps;
   int r1 = std::min(mSize.x(), mSize.y()) / 2 * 0.6;
   int r2 = std::min(mSize.x(), mSize.y()) / 2 * 0.7;
-  for (int i=0; i<=nSteps; i++)
+  int r3 = std::min(mSize.x(), mSize.y()) / 2 * 0.82;
+
+  nvgFontSize(ctx, fsize - 2);
+  nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
+  int h = fsize - 2;
+
+  mFace.ticks.clear();
+  mFace.labels.clear();
+  mFace.labelPos.clear();
+  for (int i = 0; i <= m_steps; i++)
   {
-    float ax = sin(deg2rad(m_startAngle + angleStep * i)) * r1;
-    float ay = cos(deg2rad(m_startAngle + angleStep * i)) * r1;
-    float bx = sin(deg2rad(m_startAngle + angleStep * i)) * r2;
-    float by = cos(deg2rad(m_startAngle + angleStep * i)) * r2;
-    nvgMoveTo(ctx, ax + center.x(), ay + center.y());
-    nvgLineTo(ctx, bx + center.x(), by + center.y());
+    float s = sin(deg2rad(m_startAngle + angleStep * i));
+    float c = cos(deg2rad(m_startAngle + angleStep * i));
+    mFace.ticks.push_back(Vector2f(s * r1, c * r1));
+    mFace.ticks.push_back(Vector2f(s * r2, c * r2));
+
+    double tmpVal = i * ((m_maxValue - m_minValue) / m_steps);
+    tmpVal += m_minValue;
+    std::string str = std::to_string(tmpVal);
+    str.resize(3);
+
+    int w = nvgTextBounds(ctx, 0, 0, str.c_str(), nullptr, nullptr) + 2;
+    mFace.labelPos.push_back(Vector2f(s * r3 - w / 2, c * r3 - h / 2));
+    mFace.labels.push_back(std::move(str));
+  }
+
+  mFace.thresholdAngle = (m_startAngle - m_endAngle) / (m_maxValue - m_minValue) * (m_threshold - m_minValue);
+}
+
+void Meter::drawTicks(NVGcontext *ctx)
+{
+  nvgBeginPath(ctx);
+  Vector2f center = (mPos + mSize / 2).cast<float>();
+  for (size_t i = 0; i + 1 < mFace.ticks.size(); i += 2)
+  {
+    nvgMoveTo(ctx, center.x() + mFace.ticks[i].x(), center.y() + mFace.ticks[i].y());
+    nvgLineTo(ctx, center.x() + mFace.ticks[i + 1].x(), center.y() + mFace.ticks[i + 1].y());
   }
 
   nvgStrokeColor(ctx, m_foreground);
   nvgStrokeWidth(ctx, 1);
   nvgStroke(ctx);
 
+  int r1 = std::min(mSize.x(), mSize.y()) / 2 * 0.6;
   nvgBeginPath(ctx);
   nvgArc(ctx, center.x(), center.y(), r1, deg2rad(m_endAngle + 90), deg2rad(m_startAngle + 90), NVG_CW);
   nvgStroke(ctx);
@@ -318,31 +361,14 @@ void Meter::drawTicks(NVGcontext *ctx)
 void Meter::drawScale(NVGcontext *ctx)
 {
   nvgFillColor(ctx, m_foreground);
-  //double sina,cosa;
-  //int r = std::min(width(), height());
-  Vector2i center = mPos + mSize / 2;
+  Vector2f center = (mPos + mSize / 2).cast<float>();
 
-  double angleStep = (m_endAngle - m_startAngle) / m_steps;
-  int r1 = std::min(mSize.x(), mSize.y()) / 2 * 0.82;
   nvgFontSize(ctx, fontSize() - 2);
   nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
-  int h = fontSize() - 2;
-
-  for (int i = 0; i <= m_steps; i++)
-  {
-    float ax = sin(deg2rad(m_startAngle + angleStep * i)) * r1;
-    float ay = cos(deg2rad(m_startAngle + angleStep * i)) * r1;
-
-    double tmpVal=i*((m_maxValue-m_minValue)/m_steps);
 
-    tmpVal += m_minValue;
-    std::string  str = std::to_string(tmpVal);
-    str.resize(3);
-
-    int w = nvgTextBounds(ctx, 0, 0, str.c_str(), nullptr, nullptr) + 2;
-
-    nvgText(ctx, center.x() + ax - w/2, center.y() + ay - h/2, str.c_str(), nullptr);
-  }
+  for (size_t i = 0; i < mFace.labels.size(); i++)
+    nvgText(ctx, center.x() + mFace.labelPos[i].x(), center.y() + mFace.labelPos[i].y(),
+            mFace.labels[i].c_str(), nullptr);
 }
 
 void Meter::drawUnits(NVGcontext *ctx)
@@ -389,7 +415,7 @@ void Meter::drawNumericValue(NVGcontext *ctx)
   int ypos = (mSize.y() - mValueTextRealSize.y()) / 2;
 
   nvgFontSize(ctx, fontSize()+1);
-  nvgFontFace(ctx, "sans-bold");
+  nvgFontFaceId(ctx, mTheme->mFontBold);
   nvgFillColor(ctx, color);
   nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
   nvgText(ctx, mPos.x() + xpos, mPos.y() + ypos + 0.2 * height(), m_value_text.c_str(), nullptr);
@@ -446,7 +472,7 @@ void Meter::drawThresholdLine(NVGcontext *ctx)
       return;
 
   nvgBeginPath(ctx);
-  double thresholdAngle = (m_startAngle - m_endAngle)/(m_maxValue-m_minValue)*(m_threshold-m_minValue);
+  double thresholdAngle = mFace.thresholdAngle;
   nvgStrokeWidth(ctx, 5);
   nvgStrokeColor(ctx, Color(0, 0xff, 0, 0xff));
 
@@ -88,7 +88,7 @@ void PerfGraph::draw(NVGcontext* vg)
   nvgFillColor(vg, nvgRGBA(255,192,0,128));
   nvgFill(vg);
 
-  nvgFontFace(vg, "sans");
+  nvgFontFaceId(vg, mTheme->mFontNormal);
 
   if (!mName.empty()) {
     nvgFontSize(vg, 14.0f);
@@ -1,6 +1,7 @@
 #include <nanogui/picflow.h>
 #include <nanovg.h>
 #include <nanogui/screen.h>
+#include <nanogui/imageloader.h>
 
 #define DEFAULT_SMOOTH 0.6f
 
@@ -9,17 +10,33 @@ NAMESPACE_BEGIN(nanogui)
 void PickflowItem::setTextureId( int ptx )
 {
     mTexture = ptx;
+    mLoading = false;
 }
 
 void PickflowItem::setTextureId( const std::string& pathTo )
 {
     mPath = pathTo;
-    //setTexture( Texture() );
+    mTexture = 0;
+    mLoading = !mPath.empty();
 }
 
-void PickflowItem::updateTextures( NVGcontext* ctx )
+bool PickflowItem::updateTextures( NVGcontext* ctx )
 {
+    bool changed = false;
+    if (mLoading)
+    {
+      /* Decoded in the background, poll until the image was uploaded */
+      AsyncImageLoader& loader = AsyncImageLoader::get( ctx );
+      int texture = loader.request( mPath );
+      if (texture != loader.placeholder())
+      {
+        mTexture = texture;
+        mLoading = false;
+        changed = true;
+      }
+    }
     mDownTexture = mTexture; 
+    return changed;
 }
 
 Picflow::Picflow( Widget* parent, const Vector2f& pictureRect)
@@ -46,6 +63,13 @@ uint32_t Picflow::addItem( int texture, const std::string& text, void* object )
 	return mImages.size() - 1;
 }
 
+uint32_t Picflow::addItem( const std::string& path, const std::string& text, void* object )
+{
+  uint32_t index = addItem( 0, text, object );
+  mImages[ index ].setTextureId( path );
+  return index;
+}
+
 Vector4i Picflow::_correctRect( NVGcontext* ctx, int texture, const Vector4i& rectangle )
 {
 	if (texture > 0)
@@ -192,7 +216,8 @@ void Picflow::draw( NVGcontext* ctx )
 		return;
 
   _updatetxs( ctx );
-	_updatepos();
+  if (_updatepos())
+    requestAnimationFrame();
 
   if (mDrawBackground)
   {
@@ -209,18 +234,33 @@ void Picflow::draw( NVGcontext* ctx )
 
 	if( mImages.size() > 0 )
 	{
+    /* Items are registered in drawing order, so the pick buffer returns the
+       one on top where they overlap */
+    Screen* scr = screen();
+    Vector2i origin = parent() ? parent()->absolutePosition() : Vector2i::Zero();
+    auto drawItem = [&]( int pos, float transparent )
+    {
+      const PickflowItem& item = mImages[ pos ];
+      _drawpair( ctx, item, transparent );
+      if( scr )
+        scr->pickBuffer().addRect( this, pos, Vector4i( (int)item.mCurrent.x() + origin.x(),
+                                                        (int)item.mCurrent.y() + origin.y(),
+                                                        (int)item.mCurrent.z() + origin.x(),
+                                                        (int)item.mCurrent.w() + origin.y() ) );
+    };
+
     for( int pos=std::max<int>( 0, mActiveIndex-6 ); pos < mActiveIndex; pos++ )
     {
-			_drawpair( ctx, mImages[ pos ], ( 1 - 0.1f * pos ) );
+			drawItem( pos, ( 1 - 0.1f * pos ) );
     }
 
     for( int pos=std::min<int>( mActiveIndex + 6, mImages.size()-1); pos > mActiveIndex; pos-- )
     {
-      _drawpair( ctx, mImages[ pos ], ( 1 - 0.1f * pos ) );
+      drawItem( pos, ( 1 - 0.1f * pos ) );
     }
 
 		if( mActiveIndex < static_cast< int >( mImages.size() ) )
-			_drawpair( ctx, mImages[ mActiveIndex ] );
+			drawItem( mActiveIndex, 1.f );
 	}
 
 	Widget::draw(ctx);
@@ -228,6 +268,10 @@ void Picflow::draw( NVGcontext* ctx )
 
 void Picflow::_updatetxs( NVGcontext* ctx )
 {
+  /* Item sizes depend on the texture, so arriving images need new rects */
+  for (auto& img : mImages)
+    mNeedUpdateImages |= img.updateTextures( ctx );
+
   if (mNeedUpdateImages)
   {
     _updaterects(ctx);
@@ -235,11 +279,17 @@ void Picflow::_updatetxs( NVGcontext* ctx )
   }
 }
 
-void Picflow::_updatepos()
+bool Picflow::_updatepos()
 {
+  bool moving = false;
 	for(auto& img: mImages)
 	{
     float fps = 20;
+    moving |= !math::isEqual<float>(img.mRectangle.x(), img.mCurrent.x(), 0.1f)
+              || !math::isEqual<float>(img.mRectangle.y(), img.mCurrent.y(), 0.1f)
+              || !math::isEqual<float>(img.mRectangle.z(), img.mCurrent.z(), 0.1f)
+              || !math::isEqual<float>(img.mRectangle.w(), img.mCurrent.w(), 0.1f);
+
 		if(!math::isEqual<float>(img.mRectangle.z(), img.mCurrent.z(), 0.1f) )
 		{
 			float offset = (img.mRectangle.z() - img.mCurrent.z()) / fps;
@@ -267,6 +317,7 @@ void Picflow::_updatepos()
 
     img.mMirrorRect = _getDownRect(img.mCurrent );
 	}
+  return moving;
 }
 
 void Picflow::prev( int offset )
@@ -289,6 +340,16 @@ bool Picflow::mouseButtonEvent(const Vector2i &p, int button, bool down, int mod
 {
   if (down && isMouseButtonLeft(button))
   {
+    int item = getItemAt(p.x(), p.y());
+    if (item >= 0)
+    {
+      if (item > mActiveIndex)
+        next(item - mActiveIndex);
+      else if (item < mActiveIndex)
+        prev(mActiveIndex - item);
+      return true;
+    }
+
     int side = width() / 5;
     Vector2i center = rect().center();
     int wh = mPictureRect.x() * height();
@@ -322,6 +383,8 @@ bool Picflow::mouseButtonEvent(const Vector2i &p, int button, bool down, int mod
 
     return true;
   }
+
+  return Widget::mouseButtonEvent(p, button, down, modifiers);
 }
 
 bool Picflow::keyboardEvent(int key, int scancode, int action, int modifiers)
@@ -385,6 +448,14 @@ void Picflow::setItemTexture( uint32_t index, int texture )
 	assert( index < mImages.size() );
 	if( index < mImages.size() )
 		mImages[ index ].setTextureId( texture );
+  mNeedUpdateImages = true;
+}
+
+void Picflow::setItemTexture( uint32_t index, const std::string& path )
+{
+	assert( index < mImages.size() );
+	if( index < mImages.size() )
+		mImages[ index ].setTextureId( path );
 }
 
 void Picflow::setItemBlend( uint32_t index, int blend )
@@ -396,7 +467,23 @@ void Picflow::setItemBlend( uint32_t index, int blend )
 
 int Picflow::getItemAt( int xpos, int ypos ) const
 {
-  assert( false && "func not supported" );
+  Vector2i p( xpos, ypos );
+  Screen* scr = const_cast<Picflow*>(this)->screen();
+  if( scr && scr->pickBuffer().contains( this ) )
+  {
+    Vector2i origin = parent() ? parent()->absolutePosition() : Vector2i::Zero();
+    return scr->pickBuffer().pick( this, p + origin );
+  }
+
+  /* Not drawn yet, test the rectangles in reverse drawing order */
+  if( mActiveIndex < (int)mImages.size() && mImages[ mActiveIndex ].mCurrent.isPointInside( p.cast<float>() ) )
+    return mActiveIndex;
+  for( int pos=mActiveIndex+1; pos < std::min<int>( mActiveIndex + 7, mImages.size() ); pos++ )
+    if( mImages[ pos ].mCurrent.isPointInside( p.cast<float>() ) )
+      return pos;
+  for( int pos=mActiveIndex-1; pos >= std::max<int>( 0, mActiveIndex-6 ); pos-- )
+    if( mImages[ pos ].mCurrent.isPointInside( p.cast<float>() ) )
+      return pos;
   return -1;
 }
 
@@ -422,6 +509,7 @@ PickflowItem::PickflowItem() : mPath( "" )
 {
   mTexture = 0;
   mDownTexture = 0;
+  mLoading = false;
   blend = 0xff;
   font = "sans";
   fontColor = Color( 0xff, 0, 0, 0 );
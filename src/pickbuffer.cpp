@@ -0,0 +1,188 @@
+/*
+    src/pickbuffer.cpp -- Coarse grid of the shapes drawn in a frame
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/pickbuffer.h>
+#include <nanogui/widget.h>
+#include <algorithm>
+#include <cmath>
+
+NAMESPACE_BEGIN(nanogui)
+
+void PickBuffer::Grid::reset(const Vector2i &size, int cellSize) {
+    Vector2i newCells((size.x() + cellSize - 1) / cellSize, (size.y() + cellSize - 1) / cellSize);
+    if (newCells != cells) {
+        cells = newCells;
+        lists.resize((size_t) std::max(cells.x(), 0) * std::max(cells.y(), 0));
+    }
+    for (auto &list : lists)
+        list.clear();
+}
+
+void PickBuffer::Grid::insert(uint32_t index, const Vector4i &bounds, int cellSize) {
+    int x0 = std::max(bounds.x() / cellSize, 0), y0 = std::max(bounds.y() / cellSize, 0);
+    int x1 = std::min((bounds.z() - 1) / cellSize, cells.x() - 1);
+    int y1 = std::min((bounds.w() - 1) / cellSize, cells.y() - 1);
+    for (int y = y0; y <= y1; ++y)
+        for (int x = x0; x <= x1; ++x)
+            lists[(size_t) y * cells.x() + x].push_back(index);
+}
+
+const std::vector<uint32_t> *PickBuffer::Grid::at(const Vector2i &p, int cellSize) const {
+    if (p.x() < 0 || p.y() < 0)
+        return nullptr;
+    int x = p.x() / cellSize, y = p.y() / cellSize;
+    if (x >= cells.x() || y >= cells.y())
+        return nullptr;
+    return &lists[(size_t) y * cells.x() + x];
+}
+
+void PickBuffer::clear(Widget *root, const Vector2i &size) {
+    mRoot = root;
+    mSize = size;
+    mShapes.clear();
+    mShapeGrid.reset(size, mCellSize);
+    mWidgetsValid = false;
+}
+
+void PickBuffer::addShape(const Shape &shape) {
+    const Vector4i &b = shape.bounds;
+    if (b.x() >= b.z() || b.y() >= b.w())
+        return;
+    mShapes.push_back(shape);
+    mShapeGrid.insert((uint32_t) mShapes.size() - 1, b, mCellSize);
+}
+
+void PickBuffer::addRect(const Widget *widget, int id, const Vector4i &rect) {
+    Shape shape { widget, id, Kind::Rect, rect, { } };
+    addShape(shape);
+}
+
+void PickBuffer::addCircle(const Widget *widget, int id, const Vector2f &center,
+                           float outer, float inner) {
+    Vector4i bounds((int) std::floor(center.x() - outer), (int) std::floor(center.y() - outer),
+                    (int) std::ceil(center.x() + outer) + 1, (int) std::ceil(center.y() + outer) + 1);
+    Shape shape { widget, id, Kind::Circle, bounds,
+                  { center.x(), center.y(), outer * outer, inner * inner, 0.f, 0.f } };
+    addShape(shape);
+}
+
+void PickBuffer::addTriangle(const Widget *widget, int id, const Vector2f &a,
+                             const Vector2f &b, const Vector2f &c) {
+    Vector4i bounds((int) std::floor(std::min({ a.x(), b.x(), c.x() })),
+                    (int) std::floor(std::min({ a.y(), b.y(), c.y() })),
+                    (int) std::ceil(std::max({ a.x(), b.x(), c.x() })) + 1,
+                    (int) std::ceil(std::max({ a.y(), b.y(), c.y() })) + 1);
+    Shape shape { widget, id, Kind::Triangle, bounds,
+                  { a.x(), a.y(), b.x(), b.y(), c.x(), c.y() } };
+    addShape(shape);
+}
+
+bool PickBuffer::hit(const Shape &shape, const Vector2i &p) {
+    const Vector4i &b = shape.bounds;
+    if (p.x() < b.x() || p.y() < b.y() || p.x() >= b.z() || p.y() >= b.w())
+        return false;
+    const float *d = shape.data;
+    float x = (float) p.x(), y = (float) p.y();
+    switch (shape.kind) {
+        case Kind::Rect:
+            return true;
+        case Kind::Circle: {
+            float dx = x - d[0], dy = y - d[1], r2 = dx * dx + dy * dy;
+            return r2 <= d[2] && r2 >= d[3];
+        }
+        case Kind::Triangle: {
+            /* Same sign of all edge functions, for either winding */
+            float e0 = (d[2] - d[0]) * (y - d[1]) - (d[3] - d[1]) * (x - d[0]);
+            float e1 = (d[4] - d[2]) * (y - d[3]) - (d[5] - d[3]) * (x - d[2]);
+            float e2 = (d[0] - d[4]) * (y - d[5]) - (d[1] - d[5]) * (x - d[4]);
+            return (e0 >= 0 && e1 >= 0 && e2 >= 0) || (e0 <= 0 && e1 <= 0 && e2 <= 0);
+        }
+    }
+    return false;
+}
+
+int PickBuffer::pick(const Widget *widget, const Vector2i &p) const {
+    const std::vector<uint32_t> *list = mShapeGrid.at(p, mCellSize);
+    if (!list)
+        return -1;
+    for (auto it = list->rbegin(); it != list->rend(); ++it) {
+        const Shape &shape = mShapes[*it];
+        if (shape.widget == widget && hit(shape, p))
+            return shape.id;
+    }
+    return -1;
+}
+
+bool PickBuffer::contains(const Widget *widget) const {
+    for (const Shape &shape : mShapes)
+        if (shape.widget == widget)
+            return true;
+    return false;
+}
+
+void PickBuffer::addWidgets(Widget *widget, const Vector2i &origin, const Vector4i &clip) {
+    /* Hidden subtrees are skipped without visiting their children */
+    widget->forEachVisibleChild([&](Widget *child) {
+        Vector2i pos = origin + child->position();
+        Vector4i rect(std::max(pos.x(), clip.x()), std::max(pos.y(), clip.y()),
+                      std::min(pos.x() + child->width(), clip.z()),
+                      std::min(pos.y() + child->height(), clip.w()));
+        /* Widget::findWidget only descends into children containing the point */
+        if (rect.x() >= rect.z() || rect.y() >= rect.w())
+            return;
+        mWidgets.push_back({ child, rect });
+        mWidgetGrid.insert((uint32_t) mWidgets.size() - 1, rect, mCellSize);
+        addWidgets(child, pos, rect);
+    });
+}
+
+Widget *PickBuffer::widgetAt(const Vector2i &p) {
+    if (!mRoot)
+        return nullptr;
+    if (!mWidgetsValid) {
+        mWidgets.clear();
+        mWidgetGrid.reset(mSize, mCellSize);
+        addWidgets(mRoot, mRoot->position(),
+                   Vector4i(mRoot->position().x(), mRoot->position().y(),
+                            mRoot->position().x() + mRoot->width(),
+                            mRoot->position().y() + mRoot->height()));
+        mWidgetsValid = true;
+    }
+
+    /* Entries are in pre-order and their rectangles are clipped by their
+       ancestors, so the last one containing the point is the deepest widget
+       of the topmost branch */
+    Widget *result = nullptr;
+    const std::vector<uint32_t> *list = mWidgetGrid.at(p, mCellSize);
+    if (list) {
+        for (auto it = list->rbegin(); it != list->rend() && !result; ++it) {
+            const Vector4i &r = mWidgets[*it].rect;
+            if (p.x() >= r.x() && p.y() >= r.y() && p.x() < r.z() && p.y() < r.w())
+                result = mWidgets[*it].widget;
+        }
+    }
+    if (!result)
+        return mRoot->contains(p) ? mRoot : nullptr;
+
+    /* Widget::findWidget stops at the outermost ancestor preferring the point */
+    std::vector<Widget *> chain;
+    for (Widget *w = result; w && w != mRoot; w = w->parent())
+        chain.push_back(w);
+    Vector2i origin = mRoot->position();
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        if ((*it)->prefferContains(p - origin))
+            return *it;
+        origin += (*it)->position();
+    }
+    return result;
+}
+
+NAMESPACE_END(nanogui)
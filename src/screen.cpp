@@ -14,7 +14,7 @@
 #include <nanogui/screen.h>
 #include <nanogui/window.h>
 #include <nanogui/popup.h>
-#include <set>
+#include <nanogui/imageloader.h>
 #include <nanovg.h>
 #include <algorithm>
 #include <iostream>
@@ -30,7 +30,66 @@ void Screen::addChild(int index, Widget * widget)
 
 void Screen::needPerformLayout(Widget* w)
 {
-  widgetsNeedUpdate.emplace_back(w);
+  if (!w)
+    return;
+  // a reference to itself would keep the screen alive
+  if (w == this)
+    mSelfNeedsLayout = true;
+  else if (std::find(widgetsNeedUpdate.begin(), widgetsNeedUpdate.end(), w) == widgetsNeedUpdate.end())
+    widgetsNeedUpdate.emplace_back(w);
+  mRedrawRequested = true;
+}
+
+void Screen::post(const void *key, const std::function<void()> &command)
+{
+  {
+    std::lock_guard<std::mutex> guard(mPostedMutex);
+    if (key) {
+      auto it = mPostedIndex.find(key);
+      if (it != mPostedIndex.end()) {
+        mPostedCommands[it->second].command = command;
+        return;
+      }
+      mPostedIndex[key] = mPostedCommands.size();
+    }
+    mPostedCommands.push_back({ key, command });
+  }
+
+  /* Wake up the main loop once per batch, not for every command */
+  if (!mCommandsPosted.exchange(true))
+    appPostEmptyEvent();
+}
+
+void Screen::processPostedCommands()
+{
+  if (!mCommandsPosted)
+    return;
+
+  std::vector<PostedCommand> commands;
+  {
+    std::lock_guard<std::mutex> guard(mPostedMutex);
+    commands.swap(mPostedCommands);
+    mPostedIndex.clear();
+    mCommandsPosted = false;
+  }
+
+  /* Run without holding the lock, commands may post further commands */
+  for (auto &c : commands)
+    c.command();
+  mRedrawRequested = true;
+}
+
+void Screen::requestAnimationFrame(double delay)
+{
+  double when = std::max<double>(getTimeFromStart() + delay, mLastDrawTime + mFrameInterval);
+  mNextAnimationTime = std::min(mNextAnimationTime, when);
+}
+
+void Screen::clearRedrawRequests(double now)
+{
+  mRedrawRequested = false;
+  mNextAnimationTime = std::numeric_limits<double>::infinity();
+  mLastDrawTime = now;
 }
 
 void Screen::_setupStartParams()
@@ -51,48 +110,90 @@ void Screen::_setupStartParams()
     nvgEndFrame(mNVGContext);
 }
 
+void Screen::performPendingLayout() {
+    if (widgetsNeedUpdate.empty() && !mSelfNeedsLayout)
+      return;
+
+    /* The queue holds references, so widgets removed since they were queued
+       are still alive here; those no longer on this screen are dropped */
+    std::vector<ref<Widget>> queued;
+    queued.swap(widgetsNeedUpdate);
+    std::vector<Widget*> ws;
+    for (auto& w : queued)
+      if (w->screen() == this)
+        ws.push_back(w);
+    if (mSelfNeedsLayout)
+      ws.push_back(this);
+    mSelfNeedsLayout = false;
+
+    std::vector<Widget*> order;
+    for (auto w : ws)
+    {
+      bool ancestor = false;
+      for (auto c : ws)
+        ancestor = ancestor || c->areParentsContain(w);
+      if (!ancestor)
+        order.push_back(w);
+    }
+
+    /* Layouts run in the order they were requested */
+    double start = getTimeFromStart();
+    for (auto it = order.begin(); it != order.end(); ++it) {
+      if (mLayoutBudget > 0 && it != order.begin() &&
+          getTimeFromStart() - start > mLayoutBudget) {
+        /* Out of time, continue with the rest on the next frame */
+        for (; it != order.end(); ++it)
+          needPerformLayout(*it);
+        requestAnimationFrame();
+        break;
+      }
+      (*it)->performLayout(mNVGContext);
+    }
+}
+
 void Screen::drawWidgets() {
     if (!mVisible)
         return;
 
-    if (!widgetsNeedUpdate.empty())
-    {
-      std::set<Widget*> ws;
-      for (auto w : widgetsNeedUpdate)
-        ws.insert(w);
-
-      for (auto c: widgetsNeedUpdate)
-      {
-        for (auto it = ws.begin(); it != ws.end(); )
-        {
-          if (c->areParentsContain(*it))
-            it = ws.erase(it);
-          else it++;
-        }
-      }
+    processPostedCommands();
 
-      widgetsNeedUpdate.clear();
-      for (auto& c : ws)
-        c->performLayout(mNVGContext);
+    /* Sizes depend on the theme, relayout once after it was modified */
+    if (mTheme && mTheme->version() != mThemeVersion) {
+        mThemeVersion = mTheme->version();
+        performLayout();
     }
+    performPendingLayout();
 
     _drawWidgetsBefore();
 
+    /* Upload images decoded in the background, needs the current context */
+    if (AsyncImageLoader *loader = AsyncImageLoader::find(mNVGContext))
+        if (loader->processUploads())
+            requestAnimationFrame();
+
     nvgBeginFrame(mNVGContext, mSize[0], mSize[1], mPixelRatio);
 
+    mPickBuffer.clear(this, mSize);
     draw(mNVGContext);
     afterDraw(mNVGContext);
 
     double elapsed = getTimeFromStart() - mLastInteraction;
 
+    if (elapsed < 1.0) {
+        /* Keep frames coming until a pending tooltip has faded in */
+        const Widget *widget = mPickBuffer.widgetAt(mMousePos);
+        if (widget && !widget->tooltip().empty())
+            requestAnimationFrame(elapsed < 0.5 ? 0.5 - elapsed : 0.0);
+    }
+
     if (elapsed > 0.5f) {
         /* Draw tooltips */
-        const Widget *widget = findWidget(mMousePos);
+        const Widget *widget = mPickBuffer.widgetAt(mMousePos);
         if (widget && !widget->tooltip().empty()) {
             int tooltipWidth = 150;
 
             float bounds[4];
-            nvgFontFace(mNVGContext, "sans");
+            nvgFontFaceId(mNVGContext, mTheme->mFontNormal);
             nvgFontSize(mNVGContext, 15.0f);
             nvgTextAlign(mNVGContext, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
             nvgTextLineHeight(mNVGContext, 1.1f);
@@ -162,6 +263,7 @@ bool Screen::resizeEvent(const Vector2i& size) {
 }
 
 bool Screen::cursorPosCallbackEvent(double x, double y) {
+    mRedrawRequested = true;
     Vector2i p((int) x, (int) y);
 
 #if defined(_WIN32) || defined(__linux__)
@@ -202,6 +304,7 @@ bool Screen::cursorPosCallbackEvent(double x, double y) {
 }
 
 bool Screen::mouseButtonCallbackEvent(int button, int action, int modifiers) {
+    mRedrawRequested = true;
     mModifiers = modifiers;
     mLastInteraction = getTimeFromStart();
 #if NANOGUI_USING_EXCEPTIONS
@@ -254,16 +357,19 @@ bool Screen::mouseButtonCallbackEvent(int button, int action, int modifiers) {
 }
 
 bool Screen::keyCallbackEvent(int key, int scancode, int action, int mods) {
+    mRedrawRequested = true;
     mLastInteraction = getTimeFromStart();
     return keyboardEvent(key, scancode, action, mods);
 }
 
 bool Screen::charCallbackEvent(unsigned int codepoint) {
+    mRedrawRequested = true;
     mLastInteraction = getTimeFromStart();
     return keyboardCharacterEvent(codepoint);
 }
 
 bool Screen::dropCallbackEvent(int count, const char **filenames) {
+    mRedrawRequested = true;
     std::vector<std::string> arg(count);
     for (int i = 0; i < count; ++i)
         arg[i] = filenames[i];
@@ -271,6 +377,7 @@ bool Screen::dropCallbackEvent(int count, const char **filenames) {
 }
 
 bool Screen::scrollCallbackEvent(double x, double y) {
+    mRedrawRequested = true;
     mLastInteraction = getTimeFromStart();
         if (mFocusPath.size() > 1) {
             const Window *window = mFocusPath[mFocusPath.size() - 2]->cast<Window>();
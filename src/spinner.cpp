@@ -24,6 +24,7 @@ Vector2i Spinner::preferredSize(NVGcontext *) const
 void Spinner::draw(NVGcontext* ctx)
 {
   float t = getTimeFromStart() * mSpeed;
+  requestAnimationFrame();
   float a0 = 0.0f + t * 6;
   float a1 = NVG_PI + t * 6;
   float r = (std::min(width(), height()) / 2) * mRadius;
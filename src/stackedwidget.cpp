@@ -13,6 +13,8 @@
 */
 
 #include <nanogui/stackedwidget.h>
+#include <nanogui/screen.h>
+#include <algorithm>
 
 NAMESPACE_BEGIN(nanogui)
 
@@ -23,37 +25,142 @@ StackedWidget::StackedWidget(nanogui::Widget *parent)
 
 void StackedWidget::setSelectedIndex(int index) {
     assert(index < childCount());
-    if (mSelectedIndex >= 0)
+    if (mSelectedIndex >= 0 && mSelectedIndex < childCount())
         mChildren[mSelectedIndex]->setVisible(false);
     mSelectedIndex = index;
     mChildren[mSelectedIndex]->setVisible(true);
+    mPages[mSelectedIndex].lastShown = ++mShowCounter;
+    if (mPages[mSelectedIndex].factory)
+        buildPage(mSelectedIndex);
 }
 
 int StackedWidget::selectedIndex() const {
     return mSelectedIndex;
 }
 
+Widget *StackedWidget::addLazyPage(int index, const PageFactory &factory,
+                                   const Vector2i &sizeHint) {
+    Widget *page = new Widget(nullptr);
+    addChild(index, page);
+    Page &p = mPages[index];
+    p.factory = factory;
+    p.built = false;
+    p.preferred = sizeHint;
+    p.preferredValid = true;
+    return page;
+}
+
+void StackedWidget::setMaxLoadedPages(int count) {
+    mMaxLoadedPages = std::max(count, 0);
+    unloadPages();
+}
+
+void StackedWidget::buildPage(int index) {
+    Page &page = mPages[index];
+    if (page.built)
+        return;
+    page.factory(mChildren[index]);
+    page.built = true;
+    page.layoutDirty = true;
+    page.preferredValid = false;
+    unloadPages();
+}
+
+void StackedWidget::unloadPage(int index) {
+    Widget *page = mChildren[index];
+    /* Don't leave the screen with a focus path into deleted widgets */
+    Screen *screen = this->screen();
+    if (screen && page->focused())
+        screen->updateFocus(this);
+    while (page->childCount() != 0)
+        page->removeChild(page->childCount() - 1);
+    mPages[index].built = false;
+    mPages[index].layoutDirty = true;
+}
+
+void StackedWidget::unloadPages() {
+    if (mMaxLoadedPages == 0)
+        return;
+    while (true) {
+        int loaded = 0, oldest = -1;
+        for (int i = 0; i < (int) mPages.size(); ++i) {
+            const Page &page = mPages[i];
+            if (!page.factory || !page.built)
+                continue;
+            loaded++;
+            if (i != mSelectedIndex && (oldest < 0 || page.lastShown < mPages[oldest].lastShown))
+                oldest = i;
+        }
+        if (loaded <= mMaxLoadedPages || oldest < 0)
+            break;
+        unloadPage(oldest);
+    }
+}
+
 void StackedWidget::performLayout(NVGcontext *ctx) {
-    for (auto child : mChildren) {
+    /* Layout may run on a worker thread (see appSetParallelLayout), so
+       pages are only built and unloaded from setSelectedIndex() and draw() */
+    for (int i = 0; i < childCount(); ++i) {
+        Widget *child = mChildren[i];
         child->setPosition(Vector2i::Zero());
         child->setSize(mSize);
-        child->performLayout(ctx);
+        if (i == mSelectedIndex && mPages[i].built) {
+            child->performLayout(ctx);
+            mPages[i].layoutDirty = false;
+        } else {
+            /* Laid out when it is shown */
+            mPages[i].layoutDirty = true;
+        }
     }
 }
 
 Vector2i StackedWidget::preferredSize(NVGcontext *ctx) const {
+    /* Inactive pages report the size they had when they were last measured */
     Vector2i size = Vector2i::Zero();
-    for (auto child : mChildren)
-        size = size.cwiseMax(child->preferredSize(ctx));
+    for (int i = 0; i < childCount(); ++i) {
+        const Page &page = mPages[i];
+        if (page.built && (i == mSelectedIndex || !page.preferredValid)) {
+            page.preferred = mChildren[i]->preferredSize(ctx);
+            page.preferredValid = true;
+        }
+        size = size.cwiseMax(page.preferred);
+    }
     return size;
 }
 
+void StackedWidget::draw(NVGcontext *ctx) {
+    if (mSelectedIndex >= 0 && mSelectedIndex < childCount()) {
+        Page &page = mPages[mSelectedIndex];
+        if (!page.built || page.layoutDirty) {
+            Widget *child = mChildren[mSelectedIndex];
+            buildPage(mSelectedIndex);
+            child->setPosition(Vector2i::Zero());
+            child->setSize(mSize);
+            child->performLayout(ctx);
+            page.layoutDirty = false;
+        }
+    }
+    Widget::draw(ctx);
+}
+
 void StackedWidget::addChild(int index, Widget *widget) {
-    if (mSelectedIndex >= 0)
+    if (mSelectedIndex >= 0 && mSelectedIndex < childCount())
         mChildren[mSelectedIndex]->setVisible(false);
     Widget::addChild(index, widget);
+    mPages.insert(mPages.begin() + index, Page());
     widget->setVisible(true);
     setSelectedIndex(index);
 }
 
+void StackedWidget::removeChild(int index) {
+    Widget::removeChild(index);
+    mPages.erase(mPages.begin() + index);
+}
+
+void StackedWidget::removeChild(const Widget *widget) {
+    auto it = std::find(mChildren.begin(), mChildren.end(), widget);
+    if (it != mChildren.end())
+        removeChild((int) (it - mChildren.begin()));
+}
+
 NAMESPACE_END(nanogui)
@@ -32,7 +32,7 @@ Vector2i SwitchBox::preferredSize(NVGcontext *ctx) const {
     if (mAlign == Alignment::Horizontal)
     {
       nvgFontSize(ctx, fontSize());
-      nvgFontFace(ctx, "sans");
+      nvgFontFaceId(ctx, mTheme->mFontNormal);
       return Vector2i(
         nvgTextBounds(ctx, 0, 0, mCaption.c_str(), nullptr, nullptr) +
         1.8f * fontSize(),
@@ -41,7 +41,7 @@ Vector2i SwitchBox::preferredSize(NVGcontext *ctx) const {
     else
     {
       nvgFontSize(ctx, fontSize());
-      nvgFontFace(ctx, "sans");
+      nvgFontFaceId(ctx, mTheme->mFontNormal);
       return Vector2i(
         nvgTextBounds(ctx, 0, 0, mCaption.c_str(), nullptr, nullptr) +
         1.8f * fontSize(),
@@ -168,7 +168,7 @@ void SwitchBox::draw(NVGcontext *ctx)
 #endif
 
   nvgFontSize(ctx, fontSize());
-  nvgFontFace(ctx, "sans");
+  nvgFontFaceId(ctx, mTheme->mFontNormal);
   nvgFillColor(ctx, mEnabled ? mTheme->mTextColor : mTheme->mDisabledTextColor);
   nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
   nvgText(ctx, mPos.x() + 1.6f * fontSize(), mPos.y() + mSize.y() * 0.5f, mCaption.c_str(), nullptr);
@@ -13,6 +13,8 @@
 
 #include <nanogui/tabheader.h>
 #include <nanogui/theme.h>
+#include <nanogui/textcache.h>
+#include <nanogui/fontregistry.h>
 #include <nanovg.h>
 #include <numeric>
 #include <algorithm>
@@ -21,43 +23,44 @@ NAMESPACE_BEGIN(nanogui)
 
 RTTI_IMPLEMENT_INFO(TabHeader, Widget)
 
+int TabHeader::fontHandle(NVGcontext *ctx) const {
+    if (mFontHandle == -1)
+        mFontHandle = FontRegistry::get(ctx).resolve(mFont);
+    return mFontHandle;
+}
+
 TabHeader::TabButton::TabButton(TabHeader &header, const std::string &label)
     : mHeader(&header), mLabel(label) { }
 
 Vector2i TabHeader::TabButton::preferredSize(NVGcontext *ctx) const {
-    // No need to call nvg font related functions since this is done by the tab header implementation
-    float bounds[4];
-    int labelWidth = nvgTextBounds(ctx, 0, 0, mLabel.c_str(), nullptr, bounds);
+    const TextRun &run = TextLayoutCache::get(ctx).measure(
+        mHeader->fontHandle(ctx), mHeader->fontSize(), NVG_ALIGN_LEFT | NVG_ALIGN_TOP, mLabel);
+    int labelWidth = run.advance;
     int buttonWidth = labelWidth + 2 * mHeader->theme()->mTabButtonHorizontalPadding;
-    int buttonHeight = bounds[3] - bounds[1] + 2 * mHeader->theme()->mTabButtonVerticalPadding;
+    int buttonHeight = run.bounds[3] - run.bounds[1] + 2 * mHeader->theme()->mTabButtonVerticalPadding;
     return Vector2i(buttonWidth, buttonHeight);
 }
 
 void TabHeader::TabButton::calculateVisibleString(NVGcontext *ctx) {
     // The size must have been set in by the enclosing tab header.
-    NVGtextRow displayedText;
-    nvgTextBreakLines(ctx, mLabel.c_str(), nullptr, mSize.x(), &displayedText, 1);
+    auto &cache = TextLayoutCache::get(ctx);
+    int font = mHeader->fontHandle(ctx);
+    float fontSize = mHeader->fontSize();
+    int align = NVG_ALIGN_LEFT | NVG_ALIGN_TOP;
 
+    mVisibleText.first = mLabel.c_str();
     // Check to see if the text need to be truncated.
-    if (displayedText.next[0]) {
-        auto truncatedWidth = nvgTextBounds(ctx, 0.0f, 0.0f,
-                                            displayedText.start, displayedText.end, nullptr);
-        auto dotsWidth = nvgTextBounds(ctx, 0.0f, 0.0f, dots, nullptr, nullptr);
-        while ((truncatedWidth + dotsWidth + mHeader->theme()->mTabButtonHorizontalPadding) > mSize.x()
-                && displayedText.end != displayedText.start) {
-            --displayedText.end;
-            truncatedWidth = nvgTextBounds(ctx, 0.0f, 0.0f,
-                                           displayedText.start, displayedText.end, nullptr);
-        }
-
+    if (cache.measure(font, fontSize, align, mLabel).advance > mSize.x()) {
+        auto fit = cache.fit(font, fontSize, align, mLabel,
+                             mSize.x() - mHeader->theme()->mTabButtonHorizontalPadding,
+                             Ellipsis::End, dots);
         // Remember the truncated width to know where to display the dots.
-        mVisibleWidth = truncatedWidth;
-        mVisibleText.last = displayedText.end;
+        mVisibleWidth = fit.headWidth;
+        mVisibleText.last = mLabel.c_str() + fit.headEnd;
     } else {
         mVisibleText.last = nullptr;
         mVisibleWidth = 0;
     }
-    mVisibleText.first = displayedText.start;
 }
 
 void TabHeader::TabButton::drawAtPosition(NVGcontext *ctx, const Vector2i& position, bool active) {
@@ -304,7 +307,7 @@ void TabHeader::performLayout(NVGcontext* ctx) {
 
 Vector2i TabHeader::preferredSize(NVGcontext* ctx) const {
     // Set up the nvg context for measuring the text inside the tab buttons.
-    nvgFontFace(ctx, mFont.c_str());
+    nvgFontFaceId(ctx, fontHandle(ctx));
     nvgFontSize(ctx, fontSize());
     nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
     Vector2i size = Vector2i(2*theme()->mTabControlWidth, 0);
@@ -360,7 +363,7 @@ void TabHeader::draw(NVGcontext* ctx) {
         drawControls(ctx);
 
     // Set up common text drawing settings.
-    nvgFontFace(ctx, mFont.c_str());
+    nvgFontFaceId(ctx, fontHandle(ctx));
     nvgFontSize(ctx, fontSize());
     nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
 
@@ -414,7 +417,7 @@ void TabHeader::drawControls(NVGcontext* ctx) {
     float ih = fontSize;
     ih *= icon_scale();
     nvgFontSize(ctx, ih);
-    nvgFontFace(ctx, "icons");
+    nvgFontFaceId(ctx, mTheme->mFontIcons);
     NVGcolor arrowColor;
     if (active)
         arrowColor = mTheme->mTextColor;
@@ -436,7 +439,7 @@ void TabHeader::drawControls(NVGcontext* ctx) {
     ih = fontSize;
     ih *= icon_scale();
     nvgFontSize(ctx, ih);
-    nvgFontFace(ctx, "icons");
+    nvgFontFaceId(ctx, mTheme->mFontIcons);
     float rightWidth = nvgTextBounds(ctx, 0, 0, iconRight.data(), nullptr, nullptr);
     if (active)
         arrowColor = mTheme->mTextColor;
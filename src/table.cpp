@@ -15,6 +15,11 @@ BSD-style license that can be found in the LICENSE.txt file.
 #include <nanogui/scrollbar.h>
 #include <nanogui/screen.h>
 #include <nanovg.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
 
 #define ARROW_PAD 15
 #define DEFAULT_SCROLLBAR_SIZE 16
@@ -55,14 +60,36 @@ public:
 
   void draw(NVGcontext* ctx) override
   {
+    // recently pushed values flash, fading out
+    float age = table ? table->_drawTime - changedAt : 0.f;
+    if (table && table->_highlightDuration > 0.f && age >= 0.f && age < table->_highlightDuration)
+    {
+      Color color = table->_highlightColor;
+      color.w() *= 1.f - age / table->_highlightDuration;
+      nvgBeginPath(ctx);
+      nvgRect(ctx, mPos.x(), mPos.y(), mSize.x(), mSize.y());
+      nvgFillColor(ctx, color);
+      nvgFill(ctx);
+    }
+
     if (inEditMode)
       Widget::draw(ctx);
     else
       Label::draw(ctx);
   }
 
+  //! shown while its row is in view, without requesting a layout like setVisible
+  void setShown(bool shown) { mVisible = shown; }
+
   Widget* element;
   bool inEditMode = false;
+  //! the value of a typed column changed since the caption was formatted
+  bool stale = false;
+  //! time of the last change applied by pushUpdates
+  float changedAt = -1e9f;
+  //! dropped by the next ItemsArea::removeMarkedCells
+  bool removed = false;
+  Table* table = nullptr;
   uintptr_t data;
 };
 
@@ -82,6 +109,125 @@ public:
   }
 };
 
+//! holds the cells, but only draws, lays out and dispatches to the cells
+//! of the rows in view, see Table::_syncView
+class Table::ItemsArea : public HidingElement
+{
+public:
+  ItemsArea( Widget* parent, Table* table )
+      : HidingElement(parent, Vector4i( 0, 0, 1, 1 )), table(table)
+  {
+  }
+
+  void draw(NVGcontext* ctx) override
+  {
+    nvgSave(ctx);
+    nvgTranslate(ctx, mPos.x(), mPos.y());
+    for (Cell* cell: shownCells())
+    {
+      nvgSave(ctx);
+      nvgIntersectScissor(ctx, cell->position().x(), cell->position().y(), cell->width(), cell->height());
+      cell->draw(ctx);
+      nvgRestore(ctx);
+    }
+    nvgRestore(ctx);
+  }
+
+  void performLayout(NVGcontext* ctx) override
+  {
+    // cells have a fixed size, only their elements need a layout
+    for (Cell* cell: shownCells())
+      cell->performLayout(ctx);
+  }
+
+  bool mouseButtonEvent(const Vector2i &p, int button, bool down, int modifiers) override
+  {
+    auto cells = shownCells();
+    for (auto it = cells.rbegin(); it != cells.rend(); ++it)
+    {
+      if ((*it)->contains(p - mPos) && (*it)->mouseButtonEvent(p - mPos, button, down, modifiers))
+        return true;
+    }
+    if ( isMouseButtonLeft(button) && down && !focused() )
+      requestFocus();
+    return false;
+  }
+
+  bool mouseMotionEvent(const Vector2i &p, const Vector2i &rel, int button, int modifiers) override
+  {
+    auto cells = shownCells();
+    for (auto it = cells.rbegin(); it != cells.rend(); ++it)
+    {
+      Cell* cell = *it;
+      bool contained = cell->contains(p - mPos), prevContained = cell->contains(p - mPos - rel);
+      bool found = contained;
+      if (contained != prevContained)
+      {
+        cell->mouseEnterEvent(p, contained);
+        found = true;
+      }
+      if ((contained || prevContained) && cell->mouseMotionEvent(p - mPos, rel, button, modifiers))
+        found = true;
+      if (found)
+        return true;
+    }
+    return false;
+  }
+
+  bool scrollEvent(const Vector2i &p, const Vector2f &rel) override
+  {
+    auto cells = shownCells();
+    for (auto it = cells.rbegin(); it != cells.rend(); ++it)
+    {
+      if ((*it)->contains(p - mPos) && (*it)->scrollEvent(p - mPos, rel))
+        return true;
+    }
+    return false;
+  }
+
+  void forEachVisibleChild(const std::function<void (Widget*)>& f) override
+  {
+    for (Cell* cell: shownCells())
+      f(cell);
+  }
+
+  //! removes the cells marked as removed in one pass, removeChild
+  //! would search the children again for each of them
+  void removeMarkedCells()
+  {
+    size_t kept = 0;
+    for (Widget* child: mChildren)
+    {
+      if (static_cast<Cell*>(child)->removed)
+        child->decRef();
+      else
+        mChildren[kept++] = child;
+    }
+    mChildren.resize(kept);
+  }
+
+  void removeAllCells()
+  {
+    for (Widget* child: mChildren)
+      child->decRef();
+    mChildren.clear();
+  }
+
+private:
+  //! cells of the rows in view, removed cells are hidden first
+  std::vector<Cell*> shownCells()
+  {
+    std::vector<Cell*> cells;
+    cells.reserve(table->_shownCells.size());
+    for (auto& cell: table->_shownCells)
+      if (cell->visible())
+        cells.push_back(cell);
+    return cells;
+  }
+
+  Table* table;
+};
+
 class Table::Column : public Label
 {
 public:
@@ -95,6 +241,42 @@ public:
 
     Table::ColumnOrder orderingMode;
 
+    //! values of typed columns, one per row
+    Table::ColumnType type = Table::ctText;
+    std::vector<int64_t> ints;    // ctInt64, ctTimestamp, ctEnum
+    std::vector<double> reals;    // ctDouble
+    int precision = 2;
+    std::string timeFormat = "%Y-%m-%d %H:%M:%S";
+    std::vector<std::string> enumNames;
+    //! alignment of the cells, numbers line up on the right
+    TextHAlign cellAlign = TextHAlign::hLeft;
+
+    bool isTyped() const { return type != Table::ctText; }
+
+    void insertValue(uint32_t rowIndex)
+    {
+      if (type == Table::ctDouble)
+        reals.insert(reals.begin() + rowIndex, 0.0);
+      else if (isTyped())
+        ints.insert(ints.begin() + rowIndex, 0);
+    }
+
+    void eraseValue(uint32_t rowIndex)
+    {
+      if (type == Table::ctDouble)
+        reals.erase(reals.begin() + rowIndex);
+      else if (isTyped())
+        ints.erase(ints.begin() + rowIndex);
+    }
+
+    void swapValues(uint32_t a, uint32_t b)
+    {
+      if (type == Table::ctDouble)
+        std::swap(reals[a], reals[b]);
+      else if (isTyped())
+        std::swap(ints[a], ints[b]);
+    }
+
     bool isPointInside(const Vector2i& point) const
     {
         return false;
@@ -127,7 +309,7 @@ Table::Table( Widget* parent, const std::string& id,
   _header->setSubElement( true );
 
   Widget* iaparent = new HidingElement(this, Vector4i(0, DEFAULT_SCROLLBAR_SIZE, width(), height()));
-  _itemsArea = new HidingElement(iaparent, Vector4i( 0, 0, 1, 1 ) );
+  _itemsArea = new ItemsArea(iaparent, this);
   //_itemsArea->setAlignment( alignUpperLeft, alignLowerRight, alignUpperLeft, alignLowerRight );
   _itemsArea->setSubElement( true );
 
@@ -147,6 +329,8 @@ Table::Table( Widget* parent, const std::string& id,
 
   _recalculateHeights();
   _refreshControls();
+
+  _screen = screen();
 }
 
 Table::~Table() {}
@@ -167,21 +351,20 @@ void Table::addColumn(const std::string& caption, uint32_t columnIndex)
   {
     _columns.push_back( columnHeader );
     for (Row& row: _rows)
-      row.items.push_back( new Cell( _itemsArea, Vector4i( 0, 0, 1, 1 ) ) );
+      row.items.push_back( _newCell(columnHeader) );
   }
   else
   {
     _columns.insert(_columns.begin() + columnIndex, columnHeader);
     for (Row& row: _rows)
-      row.items.insert(row.items.begin() + columnIndex, new Cell( _itemsArea, Vector4i(0, 0, 1, 1) ));
+      row.items.insert(row.items.begin() + columnIndex, _newCell(columnHeader) );
   }
 
   if (_activeTab == -1)
     _activeTab = 0;
 
-  _recalculateColumnsWidth();
-  _recalculateCells();
-  _recalculateScrollBars();
+  _rowsMoved();
+  _requestUpdate(updColumns | updCells | updScrollBars);
 }
 
 //! remove a column from the table
@@ -192,15 +375,22 @@ void Table::removeColumn(uint32_t columnIndex)
     _columns.erase( _columns.begin() + columnIndex );
     for (Row& row: _rows)
     {
-      row.items[ columnIndex ]->remove();
+      row.items[ columnIndex ]->setShown(false);
+      row.items[ columnIndex ]->removed = true;
       row.items.erase(row.items.begin() + columnIndex );
     }
+    _itemsArea->removeMarkedCells();
+    for (auto& cell: _shownCells)
+      cell->setShown(false);
+    _shownCells.clear();
+    _viewDirty = true;
   }
 
   if ( (int)columnIndex <= _activeTab )
     _activeTab = _columns.size() ? 0 : -1;
 
-  _recalculateColumnsWidth();
+  _rowsMoved();
+  _requestUpdate(updColumns);
 }
 
 
@@ -267,9 +457,7 @@ void Table::setColumnWidth(uint32_t columnIndex, uint32_t width)
     _columns[columnIndex]->setFixedWidth(width);
   }
 
-  _recalculateColumnsWidth();
-  _recalculateCells();
-  _recalculateScrollBars();
+  _requestUpdate(updColumns | updCells | updScrollBars);
 }
 
 //! Get the width of a column
@@ -302,30 +490,481 @@ uint32_t Table::addRow(uint32_t rowIndex)
     _rows[rowIndex].items[ i ] = nullptr;
 
   for ( uint32_t i = 0 ; i < _columns.size() ; ++i )
-    _rows[rowIndex].items[ i ] = new Cell( _itemsArea, Vector4i( 0, 0, 1, 1 ) );
+  {
+    _rows[rowIndex].items[ i ] = _newCell(_columns[i]);
+    _columns[i]->insertValue(rowIndex);
+    _rows[rowIndex].items[ i ]->stale = _columns[i]->isTyped();
+  }
 
-  _recalculateHeights();
-  _recalculateCells();
-  _recalculateScrollBars();
+  _rowAdded(rowIndex);
+  _requestUpdate(updHeights | updCells | updScrollBars);
   return rowIndex;
 }
 
+uint32_t Table::appendRows(uint32_t count)
+{
+  uint32_t first = _rows.size();
+  _rows.reserve(_rows.size() + count);
+  for (Column* col: _columns)
+  {
+    if ( col->type == ctDouble )
+      col->reals.reserve(col->reals.size() + count);
+    else if ( col->isTyped() )
+      col->ints.reserve(col->ints.size() + count);
+  }
+
+  beginUpdate();
+  for ( uint32_t i = 0; i < count; ++i )
+    addRow(_rows.size());
+  endUpdate();
+
+  return first;
+}
 
 void Table::removeRow(uint32_t rowIndex)
 {
-  if ( rowIndex > _rows.size() )
+  if ( rowIndex >= _rows.size() )
     return;
 
   for ( uint32_t colNum=0; colNum < _columns.size(); colNum++ )
     removeCellElement( rowIndex, colNum );
 
+  for (Cell* cell: _rows[rowIndex].items)
+  {
+    cell->setShown(false);
+    cell->remove();
+  }
+
+  for (Column* col: _columns)
+    col->eraseValue(rowIndex);
+
   _rows.erase(_rows.begin() + rowIndex );
 
   if ( !(_selectedRow < int(_rows.size())) )
     _selectedRow = _rows.size() - 1;
 
-  _recalculateHeights();
-  _recalculateScrollBars();
+  _rowsMoved();
+  _requestUpdate(updHeights | updCells | updScrollBars);
+}
+
+void Table::beginUpdate() { _updateLock++; }
+
+void Table::endUpdate()
+{
+  if ( _updateLock == 0 || --_updateLock > 0 )
+    return;
+
+  uint32_t flags = _pendingUpdate;
+  _pendingUpdate = 0;
+  _requestUpdate(flags);
+}
+
+void Table::_requestUpdate(uint32_t flags)
+{
+  if ( _updateLock > 0 )
+  {
+    _pendingUpdate |= flags;
+    return;
+  }
+
+  if ( flags & updFilter ) _applyFilter();
+  if ( flags & updColumns ) _recalculateColumnsWidth();
+  if ( flags & updHeights ) _recalculateHeights();
+  if ( flags & updCells ) _recalculateCells();
+  if ( flags & updScrollBars ) _recalculateScrollBars();
+}
+
+void Table::setColumnData(uint32_t columnIndex, const std::string* values, size_t count, uint32_t firstRow)
+{
+  if ( columnIndex >= _columns.size() )
+    return;
+
+  beginUpdate();
+  firstRow = std::min<uint32_t>(firstRow, _rows.size());
+  if ( firstRow + count > _rows.size() )
+    appendRows(firstRow + count - _rows.size());
+
+  for ( size_t i = 0; i < count; ++i )
+    setCellText(firstRow + i, columnIndex, values[i]);
+  endUpdate();
+}
+
+void Table::setColumnData(uint32_t columnIndex, const double* values, size_t count, uint32_t firstRow, int precision)
+{
+  if ( columnIndex >= _columns.size() )
+    return;
+
+  beginUpdate();
+  firstRow = std::min<uint32_t>(firstRow, _rows.size());
+  if ( firstRow + count > _rows.size() )
+    appendRows(firstRow + count - _rows.size());
+
+  char buf[64];
+  for ( size_t i = 0; i < count; ++i )
+  {
+    if ( _columns[columnIndex]->isTyped() )
+    {
+      setCellDouble(firstRow + i, columnIndex, values[i]);
+      continue;
+    }
+    snprintf(buf, sizeof(buf), "%.*f", precision, values[i]);
+    setCellText(firstRow + i, columnIndex, buf);
+  }
+  endUpdate();
+}
+
+void Table::setColumnData(uint32_t columnIndex, const int64_t* values, size_t count, uint32_t firstRow)
+{
+  if ( columnIndex >= _columns.size() )
+    return;
+
+  beginUpdate();
+  firstRow = std::min<uint32_t>(firstRow, _rows.size());
+  if ( firstRow + count > _rows.size() )
+    appendRows(firstRow + count - _rows.size());
+
+  for ( size_t i = 0; i < count; ++i )
+    setCellInt(firstRow + i, columnIndex, values[i]);
+  endUpdate();
+}
+
+void Table::pushUpdates(const std::vector<CellUpdate>& updates)
+{
+  if ( updates.empty() )
+    return;
+
+  {
+    std::lock_guard<std::mutex> guard(_pushedMutex);
+    for (const CellUpdate& update: updates)
+    {
+      uint64_t key = (uint64_t)update.row << 32 | update.column;
+      auto it = _pushedIndex.find(key);
+      if ( it != _pushedIndex.end() )
+        _pushed[it->second] = update;
+      else
+      {
+        _pushedIndex[key] = _pushed.size();
+        _pushed.push_back(update);
+      }
+    }
+  }
+
+  // one posted command per frame applies everything queued until then
+  if ( !_updatesPosted.exchange(true) )
+  {
+    if ( Screen* scr = _screen.load() )
+    {
+      ref<Table> self(this);
+      scr->post(this, [self]() mutable { self->_applyPushedUpdates(); });
+    }
+    else
+      _updatesPosted = false;
+  }
+}
+
+void Table::_applyPushedUpdates()
+{
+  std::vector<CellUpdate> updates;
+  {
+    std::lock_guard<std::mutex> guard(_pushedMutex);
+    updates.swap(_pushed);
+    _pushedIndex.clear();
+    _updatesPosted = false;
+  }
+
+  // column widths are fixed, so new values never change the layout; only an
+  // active filter has to be reapplied, once for the whole batch
+  float now = getTimeFromStart();
+  beginUpdate();
+  for (const CellUpdate& update: updates)
+  {
+    Cell* cell = _getCell(update.row, update.column);
+    if ( !cell )
+      continue;
+
+    switch (update.kind)
+    {
+      case CellUpdate::Text: setCellText(update.row, update.column, update.text); break;
+      case CellUpdate::Int: setCellInt(update.row, update.column, update.intValue); break;
+      case CellUpdate::Double: setCellDouble(update.row, update.column, update.doubleValue); break;
+    }
+    cell->changedAt = now;
+  }
+  endUpdate();
+
+  if ( _highlightDuration > 0.f && !updates.empty() )
+  {
+    _highlightEnd = now + _highlightDuration;
+    requestAnimationFrame();
+  }
+}
+
+Table::Cell* Table::_newCell(const Column* column)
+{
+  Cell* cell = new Cell( _itemsArea, Vector4i( 0, 0, 1, 1 ) );
+  cell->table = this;
+  cell->setTextHAlign(column->cellAlign);
+  // shown once its row scrolls into view
+  cell->setShown(false);
+  _viewDirty = true;
+  return cell;
+}
+
+void Table::setColumnType(uint32_t columnIndex, ColumnType type)
+{
+  if ( columnIndex >= _columns.size() || type >= ctCount || type == _columns[columnIndex]->type )
+    return;
+
+  Column* column = _columns[columnIndex];
+  if ( type == ctText )
+  {
+    // keep what the values showed
+    for ( uint32_t row = 0; row < _rows.size(); ++row )
+    {
+      _rows[row].items[columnIndex]->setCaption( _formatValue(column, row) );
+      _rows[row].items[columnIndex]->stale = false;
+    }
+    column->type = type;
+    column->ints.clear();
+    column->reals.clear();
+  }
+  else
+  {
+    // parse the captions before the column holds values of the new type
+    std::vector<std::string> texts(_rows.size());
+    for ( uint32_t row = 0; row < _rows.size(); ++row )
+      texts[row] = getCellText(row, columnIndex);
+
+    column->type = type;
+    column->ints.assign(type == ctDouble ? 0 : _rows.size(), 0);
+    column->reals.assign(type == ctDouble ? _rows.size() : 0, 0.0);
+    for ( uint32_t row = 0; row < _rows.size(); ++row )
+    {
+      _parseValue(column, row, texts[row]);
+      _rows[row].items[columnIndex]->stale = true;
+    }
+  }
+
+  // numbers line up on the right, cells added later follow the column
+  column->cellAlign = type == ctInt64 || type == ctDouble ? TextHAlign::hRight : TextHAlign::hLeft;
+  for (Row& row: _rows)
+    row.items[columnIndex]->setTextHAlign(column->cellAlign);
+
+  _rowsMoved();
+}
+
+Table::ColumnType Table::getColumnType(uint32_t columnIndex) const
+{
+  return columnIndex < _columns.size() ? _columns[columnIndex]->type : ctText;
+}
+
+void Table::setColumnPrecision(uint32_t columnIndex, int precision)
+{
+  if ( columnIndex >= _columns.size() )
+    return;
+
+  _columns[columnIndex]->precision = precision;
+  for (Row& row: _rows)
+    row.items[columnIndex]->stale = _columns[columnIndex]->isTyped();
+  _rowsMoved();
+}
+
+void Table::setColumnTimeFormat(uint32_t columnIndex, const std::string& format)
+{
+  if ( columnIndex >= _columns.size() )
+    return;
+
+  _columns[columnIndex]->timeFormat = format;
+  for (Row& row: _rows)
+    row.items[columnIndex]->stale = _columns[columnIndex]->isTyped();
+  _rowsMoved();
+}
+
+void Table::setColumnEnumNames(uint32_t columnIndex, const std::vector<std::string>& names)
+{
+  if ( columnIndex >= _columns.size() )
+    return;
+
+  _columns[columnIndex]->enumNames = names;
+  for (Row& row: _rows)
+    row.items[columnIndex]->stale = _columns[columnIndex]->isTyped();
+  _rowsMoved();
+}
+
+void Table::setCellInt(uint32_t rowIndex, uint32_t columnIndex, int64_t value)
+{
+  if ( rowIndex >= _rows.size() || columnIndex >= _columns.size() )
+    return;
+
+  Column* column = _columns[columnIndex];
+  if ( !column->isTyped() )
+  {
+    setCellText(rowIndex, columnIndex, std::to_string(value));
+    return;
+  }
+
+  if ( column->type == ctDouble )
+    column->reals[rowIndex] = (double)value;
+  else
+    column->ints[rowIndex] = value;
+
+  _rows[rowIndex].items[columnIndex]->stale = true;
+  _rowTextChanged(rowIndex);
+}
+
+void Table::setCellDouble(uint32_t rowIndex, uint32_t columnIndex, double value)
+{
+  if ( rowIndex >= _rows.size() || columnIndex >= _columns.size() )
+    return;
+
+  Column* column = _columns[columnIndex];
+  if ( !column->isTyped() )
+  {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", column->precision, value);
+    setCellText(rowIndex, columnIndex, buf);
+    return;
+  }
+
+  if ( column->type == ctDouble )
+    column->reals[rowIndex] = value;
+  else
+    column->ints[rowIndex] = (int64_t)std::llround(value);
+
+  _rows[rowIndex].items[columnIndex]->stale = true;
+  _rowTextChanged(rowIndex);
+}
+
+int64_t Table::getCellInt(uint32_t rowIndex, uint32_t columnIndex) const
+{
+  if ( rowIndex >= _rows.size() || columnIndex >= _columns.size() )
+    return 0;
+
+  const Column* column = _columns[columnIndex];
+  if ( column->type == ctDouble )
+    return (int64_t)std::llround(column->reals[rowIndex]);
+
+  return column->isTyped() ? column->ints[rowIndex] : 0;
+}
+
+double Table::getCellDouble(uint32_t rowIndex, uint32_t columnIndex) const
+{
+  if ( rowIndex >= _rows.size() || columnIndex >= _columns.size() )
+    return 0.0;
+
+  const Column* column = _columns[columnIndex];
+  if ( column->type == ctDouble )
+    return column->reals[rowIndex];
+
+  return column->isTyped() ? (double)column->ints[rowIndex] : 0.0;
+}
+
+std::string Table::_formatValue(const Column* column, uint32_t rowIndex) const
+{
+  char buf[128];
+  switch (column->type)
+  {
+    case ctInt64:
+      return std::to_string(column->ints[rowIndex]);
+
+    case ctDouble:
+      snprintf(buf, sizeof(buf), "%.*f", column->precision, column->reals[rowIndex]);
+      return buf;
+
+    case ctTimestamp:
+    {
+      std::time_t time = (std::time_t)column->ints[rowIndex];
+      std::tm* tm = std::localtime(&time);
+      if ( tm && std::strftime(buf, sizeof(buf), column->timeFormat.c_str(), tm) > 0 )
+        return buf;
+      return std::to_string(column->ints[rowIndex]);
+    }
+
+    case ctEnum:
+    {
+      int64_t value = column->ints[rowIndex];
+      if ( value >= 0 && value < (int64_t)column->enumNames.size() )
+        return column->enumNames[value];
+      return std::to_string(value);
+    }
+
+    default:
+      return "";
+  }
+}
+
+void Table::_parseValue(Column* column, uint32_t rowIndex, const std::string& text)
+{
+  if ( column->type == ctDouble )
+  {
+    column->reals[rowIndex] = std::strtod(text.c_str(), nullptr);
+    return;
+  }
+
+  if ( column->type == ctEnum )
+  {
+    auto it = std::find(column->enumNames.begin(), column->enumNames.end(), text);
+    if ( it != column->enumNames.end() )
+    {
+      column->ints[rowIndex] = it - column->enumNames.begin();
+      return;
+    }
+  }
+
+  column->ints[rowIndex] = std::strtoll(text.c_str(), nullptr, 10);
+}
+
+void Table::_syncView(NVGcontext* ctx)
+{
+  int first = 0, last = 0;
+  if ( _itemHeight > 0 )
+  {
+    first = std::max(_viewTop / _itemHeight, 0);
+    last = std::min(_viewBottom / _itemHeight + 1, getVisibleRowCount());
+  }
+
+  if ( !_viewDirty && first == _shownFirst && last == _shownLast )
+    return;
+
+  for (auto& cell: _shownCells)
+    cell->setShown(false);
+  _shownCells.clear();
+
+  for ( int visibleIndex = first; visibleIndex < last; ++visibleIndex )
+  {
+    Row& row = _rows[getVisibleRow(visibleIndex)];
+    for ( uint32_t col = 0; col < _columns.size(); ++col )
+    {
+      Cell* cell = row.items[col];
+      cell->setPosition(_columns[col]->position().x(), visibleIndex * _itemHeight);
+      cell->setSize({ _columns[col]->width(), _itemHeight });
+      cell->setFixedSize({ _columns[col]->width(), _itemHeight });
+      cell->setShown(true);
+      cell->performLayout(ctx);
+      _shownCells.push_back(cell);
+    }
+  }
+
+  _shownFirst = first;
+  _shownLast = last;
+  _viewDirty = false;
+}
+
+void Table::_formatVisibleCells()
+{
+  for ( int visibleIndex = _shownFirst; visibleIndex < _shownLast; ++visibleIndex )
+  {
+    uint32_t row = getVisibleRow(visibleIndex);
+    for ( uint32_t col = 0; col < _columns.size(); ++col )
+    {
+      Cell* cell = _rows[row].items[col];
+      if ( cell->stale )
+      {
+        cell->setCaption( _formatValue(_columns[col], row) );
+        cell->stale = false;
+      }
+    }
+  }
 }
 
 //! adds an list item, returns id of item
@@ -333,7 +972,15 @@ void Table::setCellText(uint32_t rowIndex, uint32_t columnIndex, const std::stri
 {
   if ( rowIndex < _rows.size() && columnIndex < _columns.size() )
   {
-    _rows[rowIndex].items[columnIndex]->setCaption( text );
+    // typed columns keep the parsed value, the caption follows when drawn
+    if ( _columns[columnIndex]->isTyped() )
+    {
+      _parseValue(_columns[columnIndex], rowIndex, text);
+      _rows[rowIndex].items[columnIndex]->stale = true;
+    }
+    else
+      _rows[rowIndex].items[columnIndex]->setCaption( text );
+    _rowTextChanged(rowIndex);
   }
 }
 
@@ -341,7 +988,7 @@ void Table::setCellText(uint32_t rowIndex, uint32_t columnIndex, const std::stri
 {
   if ( rowIndex < _rows.size() && columnIndex < _columns.size() )
   {
-    _rows[rowIndex].items[columnIndex]->setCaption( text );
+    setCellText(rowIndex, columnIndex, text);
     _rows[rowIndex].items[columnIndex]->setColor( color );
   }
 }
@@ -361,7 +1008,11 @@ void Table::setCellDataptr(uint32_t rowIndex, uint32_t columnIndex, uintptr_t da
 std::string Table::getCellText(uint32_t rowIndex, uint32_t columnIndex ) const
 {
   if ( rowIndex < _rows.size() && columnIndex < _columns.size() )
+  {
+    if ( _columns[columnIndex]->isTyped() )
+      return _formatValue(_columns[columnIndex], rowIndex);
     return _rows[rowIndex].items[columnIndex]->caption();
+  }
 
   return "";
 }
@@ -390,8 +1041,7 @@ void Table::clear()
   if (_verticalScrollBar) _verticalScrollBar->setScroll(0);
   if ( _horizontalScrollBar )  _horizontalScrollBar->setScroll(0);
 
-  _recalculateHeights();
-  _recalculateColumnsWidth();
+  _requestUpdate(updHeights | updColumns);
 }
 
 void Table::clearContent()
@@ -400,22 +1050,31 @@ void Table::clearContent()
         for ( uint32_t colNum=0; colNum < _columns.size(); colNum++ )
             removeCellElement( rowNum, colNum );
 
-    _recalculateCells();
+    _requestUpdate(updCells);
 }
 
 void Table::clearRows()
 {
   _selectedRow = -1;
 
-  const auto& tableAreaChilds = _itemsArea->children();
-  for (auto& w: tableAreaChilds )
-    w->remove();
+  // all at once, removing cells one by one searches the children each time
+  _itemsArea->removeAllCells();
+  for (auto& cell: _shownCells)
+    cell->setShown(false);
+  _shownCells.clear();
 
   _rows.clear();
 
+  for (Column* col: _columns)
+  {
+    col->ints.clear();
+    col->reals.clear();
+  }
+
   if (_verticalScrollBar) _verticalScrollBar->setScroll(0);
 
-  _recalculateHeights();
+  _rowsMoved();
+  _requestUpdate(updHeights);
 }
 
 int Table::getSelected() const { return _selectedRow; }
@@ -428,6 +1087,104 @@ void Table::setSelected( int index )
     _selectedRow = index;
 }
 
+void Table::setFilter(const std::string& query)
+{
+  if ( query == _filter )
+    return;
+
+  _filter = query;
+  if (_verticalScrollBar) _verticalScrollBar->setScroll(0);
+  _requestUpdate(updFilter | updHeights | updCells | updScrollBars);
+}
+
+int Table::getVisibleRowCount() const
+{
+  return _filter.empty() ? (int)_rows.size() : (int)_visibleRows.size();
+}
+
+int Table::getVisibleRow(int visibleIndex) const
+{
+  if ( visibleIndex < 0 || visibleIndex >= getVisibleRowCount() )
+    return -1;
+
+  return _filter.empty() ? visibleIndex : (int)_visibleRows[visibleIndex];
+}
+
+std::string Table::_rowText(uint32_t rowIndex) const
+{
+  std::string text;
+  for ( uint32_t col = 0; col < _columns.size(); ++col )
+  {
+    text += getCellText(rowIndex, col);
+    text += '\t';
+  }
+  return text;
+}
+
+void Table::_rowAdded(uint32_t rowIndex)
+{
+  // the index is only kept up to date once a filter was used
+  if ( _filterIndexValid && rowIndex == _filterIndex.size() )
+    _filterIndex.append(_rowText(rowIndex));
+  else
+    _filterIndexValid = false;
+
+  if ( !_filter.empty() )
+    _requestUpdate(updFilter);
+}
+
+void Table::_rowTextChanged(uint32_t rowIndex)
+{
+  // the row is indexed again when the filter is next applied
+  if ( _filterIndexValid && rowIndex < _filterIndex.size() )
+  {
+    if ( _indexRowDirty.size() < _filterIndex.size() )
+      _indexRowDirty.resize(_filterIndex.size(), false);
+    if ( !_indexRowDirty[rowIndex] )
+    {
+      _indexRowDirty[rowIndex] = true;
+      _dirtyIndexRows.push_back(rowIndex);
+    }
+  }
+
+  // writes faster than the frame rate filter once per frame, see draw
+  if ( !_filter.empty() )
+    _filterStale = true;
+}
+
+void Table::_rowsMoved()
+{
+  _filterIndexValid = false;
+  _requestUpdate(updCells | (_filter.empty() ? 0 : updFilter | updHeights | updScrollBars));
+}
+
+void Table::_applyFilter()
+{
+  _filterStale = false;
+  _visibleRows.clear();
+  if ( _filter.empty() )
+    return;
+
+  if ( !_filterIndexValid )
+  {
+    std::vector<std::string> texts(_rows.size());
+    for ( uint32_t i = 0; i < _rows.size(); ++i )
+      texts[i] = _rowText(i);
+    _filterIndex.build(texts);
+    _filterIndexValid = true;
+  }
+  else
+  {
+    for ( uint32_t row : _dirtyIndexRows )
+      if ( row < _filterIndex.size() )
+        _filterIndex.update(row, _rowText(row));
+  }
+  _dirtyIndexRows.clear();
+  _indexRowDirty.clear();
+
+  _visibleRows = _filterIndex.search(_filter);
+}
+
 void Table::_recalculateColumnsWidth()
 {
   _totalItemWidth=0;
@@ -449,7 +1206,7 @@ void Table::_recalculateHeights()
   int fontH = bounds[3] - bounds[1] + (_cellHeightPadding * 2);
   _itemHeight = _overItemHeight == 0 ? fontH : _overItemHeight;
 
-  _totalItemHeight = _itemHeight * _rows.size();    //  header is not counted, because we only want items
+  _totalItemHeight = _itemHeight * getVisibleRowCount();    //  header is not counted, because we only want items
 }
 
 
@@ -543,25 +1300,13 @@ void Table::_refreshControls()
 
 void Table::_recalculateCells()
 {
-  int yPos = 0;
-  int xPos = 0;
-  for (auto& row: _rows)
-  {
-    auto cit = _columns.begin();
-    xPos = 0;
-    for (int index=0; cit != _columns.end(); cit++, index++ )
-    {
-      row.items[index]->setPosition((*cit)->position().x(), yPos);
-      row.items[index]->setSize({ (*cit)->width(), _itemHeight });
-      row.items[index]->setFixedSize({ (*cit)->width(), _itemHeight });
-      row.items[index]->sendToBack();
-      xPos += (*cit)->width();
-    }
-
-    yPos += _itemHeight;
-  }
+  // only the rows in view get their cells placed, see _syncView
+  int width = 0;
+  for (Column* col: _columns)
+    width += col->width();
 
-  _itemsArea->setFixedSize({ xPos, yPos });
+  _itemsArea->setFixedSize({ width, getVisibleRowCount() * _itemHeight });
+  _viewDirty = true;
 }
 
 bool Table::scrollEvent(const Vector2i &p, const Vector2f &rel)
@@ -641,10 +1386,17 @@ void Table::swapRows(uint32_t rowIndexA, uint32_t rowIndexB)
   _rows[rowIndexA] = _rows[rowIndexB];
   _rows[rowIndexB] = swap;
 
+  for (Column* col: _columns)
+    col->swapValues(rowIndexA, rowIndexB);
+
   if ( _selectedRow == int(rowIndexA) )
     _selectedRow = rowIndexB;
   else if ( _selectedRow == int(rowIndexB) )
     _selectedRow = rowIndexA;
+
+  _rowTextChanged(rowIndexA);
+  _rowTextChanged(rowIndexB);
+  _requestUpdate(updCells);
 }
 
 bool Table::_dragColumnStart(int xpos, int ypos)
@@ -735,60 +1487,64 @@ bool Table::_selectColumnHeader(int xpos, int ypos)
   return false;
 }
 
-bool _nstrCmp(const std::string& s1, const std::string& s2)
-{
-  return strcmp(s1.c_str(), s2.c_str());
-}
-
 void Table::orderRows(int columnIndex, RowOrder mode)
 {
-  Row swap;
-
   if ( columnIndex == -1 )
     columnIndex = getActiveColumn();
-  if ( columnIndex < 0 )
+  if ( columnIndex < 0 || columnIndex >= (int)_columns.size() || mode == RowOrder::roNone )
     return;
 
-  if ( mode == RowOrder::roAscending )
+  // typed columns compare their values, text columns their captions
+  const Column* column = _columns[columnIndex];
+  auto less = [&](uint32_t a, uint32_t b)
   {
-    for ( int i = 0 ; i < int(_rows.size()) - 1 ; ++i )
+    switch (column->type)
     {
-      for ( int j = 0 ; j < int(_rows.size()) - i - 1 ; ++j )
-      {
-        if (_nstrCmp(_rows[j+1].items[columnIndex]->caption(), _rows[j].items[columnIndex]->caption()) )
-        {
-          swap = _rows[j];
-          _rows[j] = _rows[j+1];
-          _rows[j+1] = swap;
-
-          if ( _selectedRow == j )
-            _selectedRow = j+1;
-          else if ( _selectedRow == j+1 )
-            _selectedRow = j;
-        }
-      }
+      case ctText: return _rows[a].items[columnIndex]->caption() < _rows[b].items[columnIndex]->caption();
+      case ctDouble: return column->reals[a] < column->reals[b];
+      default: return column->ints[a] < column->ints[b];
     }
+  };
+
+  std::vector<uint32_t> order(_rows.size());
+  for ( uint32_t i = 0; i < order.size(); ++i )
+    order[i] = i;
+
+  if ( mode == RowOrder::roAscending )
+    std::stable_sort(order.begin(), order.end(), less);
+  else
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return less(b, a); });
+
+  Rows rows(_rows.size());
+  int selected = -1;
+  for ( uint32_t i = 0; i < order.size(); ++i )
+  {
+    rows[i] = _rows[order[i]];
+    if ( (int)order[i] == _selectedRow )
+      selected = i;
   }
-  else if ( mode == RowOrder::roDescending )
+  _rows.swap(rows);
+  _selectedRow = selected;
+
+  for (Column* col: _columns)
   {
-    for ( int i = 0 ; i < int(_rows.size()) - 1 ; ++i )
+    if ( col->type == ctDouble )
     {
-      for ( int j = 0 ; j < int(_rows.size()) - i - 1 ; ++j )
-      {
-        if ( _nstrCmp(_rows[j].items[columnIndex]->caption(), _rows[j+1].items[columnIndex]->caption()) )
-        {
-          swap = _rows[j];
-          _rows[j] = _rows[j+1];
-          _rows[j+1] = swap;
-
-          if ( _selectedRow == j )
-            _selectedRow = j+1;
-          else if ( _selectedRow == j+1 )
-            _selectedRow = j;
-        }
-      }
+      std::vector<double> reals(order.size());
+      for ( uint32_t i = 0; i < order.size(); ++i )
+        reals[i] = col->reals[order[i]];
+      col->reals.swap(reals);
+    }
+    else if ( col->isTyped() )
+    {
+      std::vector<int64_t> ints(order.size());
+      for ( uint32_t i = 0; i < order.size(); ++i )
+        ints[i] = col->ints[order[i]];
+      col->ints.swap(ints);
     }
   }
+
+  _rowsMoved();
 }
 
 void Table::_selectNew( int xpos, int ypos, bool lmb, bool onlyHover)
@@ -799,17 +1555,16 @@ void Table::_selectNew( int xpos, int ypos, bool lmb, bool onlyHover)
   if ( ypos < ( absolutePosition().y() + _itemHeight ) )
     return;
 
-  // find new selected item.
+  // find new selected item, positions count the rows passing the filter
   if (_itemHeight!=0)
-    _selectedRow = ((ypos - absolutePosition().y() - _itemHeight - 1) + (_verticalScrollBar->scroll() * _vscrollsize)) / _itemHeight;
+  {
+    int visibleIndex = ((ypos - absolutePosition().y() - _itemHeight - 1) + (_verticalScrollBar->scroll() * _vscrollsize)) / _itemHeight;
+    visibleIndex = std::min(visibleIndex, getVisibleRowCount() - 1);
+    _selectedRow = getVisibleRow(std::max(visibleIndex, 0));
+  }
 
   _selectedColumn = _getCurrentColumn( xpos, ypos );
 
-  if (_selectedRow >= (int)_rows.size())
-    _selectedRow = _rows.size() - 1;
-  else if (_selectedRow<0)
-    _selectedRow = 0;
-
   // post the news
   if ( !onlyHover )
   {
@@ -849,10 +1604,14 @@ void Table::_startEditCell(int col, int row)
     _edit->setFixedSize(cell->size());
     _edit->setEditable(true);
     _edit->requestFocus();
-    _edit->setComitCallback([cell, this](Widget* w) {
+    _edit->setComitCallback([cell, row, col, this](Widget* w) {
       if (TextBox* ed = w->cast<TextBox>())
       {
-        cell->setCaption(ed->value());
+        // the row may have moved while editing
+        if (_getCell(row, col) == cell)
+          setCellText(row, col, ed->value());
+        else
+          cell->setCaption(ed->value());
         cell->requestFocus();
         cell->inEditMode = false;
       }
@@ -891,16 +1650,36 @@ void Table::draw(NVGcontext* ctx)
   int xOffset = _horizontalScrollBar->scroll() * _hscrollsize;
 
   _header->setPosition(-xOffset, _header->position().y());
-  _itemsArea->setPosition(-xOffset, 0);
+  _itemsArea->setPosition(-xOffset, -yOffset);
+
+  // walking the parents is only safe here, pushUpdates posts through this
+  _screen = screen();
+
+  if ( _filterStale )
+    _requestUpdate(updFilter | updHeights | updCells | updScrollBars);
+
+  // keep frames coming while pushed changes fade out
+  _drawTime = getTimeFromStart();
+  if ( _drawTime < _highlightEnd )
+    requestAnimationFrame();
+
+  // only rows in view are placed, formatted and drawn
+  _viewTop = yOffset;
+  _viewBottom = yOffset + _itemsArea->parent()->height();
+  _syncView(ctx);
+  _formatVisibleCells();
+
+  int firstRow = _shownFirst;
+  int lastRow = _shownLast;
 
   if (_drawflags.test(drawRows))
   {
     nvgBeginPath(ctx);
     nvgStrokeColor(ctx, Color(0xc0, 0x80));
 
-    for (uint32_t i = 0; i < _rows.size(); ++i)
+    for (int i = firstRow; i < lastRow; ++i)
     {
-      Vector4i r = _rows[i].items.front()->absoluteRect();
+      Vector4i r = _rows[getVisibleRow(i)].items.front()->absoluteRect();
       //r.y() = r.w() - 1;
       r.z() = position().x() + width();
       nvgRect(ctx, r.x(), r.y(), r.z() - r.x(), r.w() - r.y());
@@ -915,7 +1694,8 @@ void Table::draw(NVGcontext* ctx)
     nvgStrokeColor(ctx, Color(0xff, 0x0, 0x0, 0x80));
     if (_selectedRow >= 0 && _selectedRow < _rows.size()
         && _selectedColumn >= 0 && _selectedColumn < _columns.size()
-        && _drawflags.test(drawActiveRow))
+        && _drawflags.test(drawActiveRow)
+        && _rows[_selectedRow].items[_selectedColumn]->visible())
     {
       Vector4i r(_rows[_selectedRow].items[_selectedColumn]->absoluteRect());
       nvgRect(ctx, r.x(), r.y(), r.z() - r.x(), r.w() - r.y());
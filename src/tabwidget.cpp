@@ -83,6 +83,22 @@ Widget* TabWidget::createTab(const std::string &label) {
     return createTab(tabCount(), label);
 }
 
+Widget *TabWidget::createLazyTab(int index, const std::string &label,
+                                 const StackedWidget::PageFactory &factory,
+                                 const Vector2i &sizeHint) {
+    assert(index <= tabCount());
+    Widget *tab = mContent->addLazyPage(index, factory, sizeHint);
+    mHeader->addTab(index, label);
+    assert(mHeader->tabCount() == mContent->childCount());
+    return tab;
+}
+
+Widget *TabWidget::createLazyTab(const std::string &label,
+                                 const StackedWidget::PageFactory &factory,
+                                 const Vector2i &sizeHint) {
+    return createLazyTab(tabCount(), label, factory, sizeHint);
+}
+
 void TabWidget::addTab(const std::string &name, Widget *tab) {
     addTab(tabCount(), name, tab);
 }
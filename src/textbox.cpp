@@ -17,6 +17,7 @@
 #include <nanogui/textbox.h>
 #include <nanovg.h>
 #include <nanogui/theme.h>
+#include <nanogui/textcache.h>
 #include <nanogui/serializer/core.h>
 #include <regex>
 #include <iostream>
@@ -71,14 +72,14 @@ Vector2i TextBox::preferredSize(NVGcontext *ctx) const {
         float uh = size.y() * 0.4f;
         uw = w * uh / h;
     } else if (!mUnits.empty()) {
-        uw = nvgTextBounds(ctx, 0, 0, mUnits.c_str(), nullptr, nullptr);
+        uw = TextLayoutCache::get(ctx).measure(mTheme->mFontNormal, fontSize(), NVG_ALIGN_LEFT | NVG_ALIGN_TOP, mUnits).advance;
     }
     float sw = 0;
     if (mSpinnable) {
         sw = 14.f;
     }
 
-    float ts = nvgTextBounds(ctx, 0, 0, mValue.c_str(), nullptr, nullptr);
+    float ts = TextLayoutCache::get(ctx).measure(mTheme->mFontNormal, fontSize(), NVG_ALIGN_LEFT | NVG_ALIGN_TOP, mValue).advance;
     size.x() = size.y() + ts + uw + sw;
     if (mFixedSize.x() > 0)
       size.x() = mFixedSize.x();
@@ -120,7 +121,7 @@ void TextBox::draw(NVGcontext* ctx) {
     nvgStroke(ctx);
 
     nvgFontSize(ctx, fontSize());
-    nvgFontFace(ctx, "sans");
+    nvgFontFaceId(ctx, mTheme->mFontNormal);
     Vector2i drawPos(mPos.x(), mPos.y() + mSize.y() * 0.5f + 1);
 
     float xSpacing = mSize.y() * 0.3f;
@@ -143,9 +144,9 @@ void TextBox::draw(NVGcontext* ctx) {
         nvgFill(ctx);
         unitWidth += 2;
     } else if (!mUnits.empty()) {
-        unitWidth = nvgTextBounds(ctx, 0, 0, mUnits.c_str(), nullptr, nullptr);
+        unitWidth = TextLayoutCache::get(ctx).measure(
+            mTheme->mFontNormal, fontSize(), NVG_ALIGN_RIGHT | NVG_ALIGN_MIDDLE, mUnits).advance;
         nvgFillColor(ctx, Color(255, mEnabled ? 64 : 32));
-        nvgTextAlign(ctx, NVG_ALIGN_RIGHT | NVG_ALIGN_MIDDLE);
         nvgText(ctx, mPos.x() + mSize.x() - xSpacing, drawPos.y(),
                 mUnits.c_str(), nullptr);
         unitWidth += 2;
@@ -156,7 +157,7 @@ void TextBox::draw(NVGcontext* ctx) {
     if (mSpinnable && !focused()) {
         spinArrowsWidth = 14.f;
 
-        nvgFontFace(ctx, "icons");
+        nvgFontFaceId(ctx, mTheme->mFontIcons);
         nvgFontSize(ctx, ((mFontSize < 0) ? mTheme->mButtonFontSize : mFontSize) * icon_scale());
 
         bool spinning = mMouseDownPos.x() != -1;
@@ -182,7 +183,7 @@ void TextBox::draw(NVGcontext* ctx) {
         }
 
         nvgFontSize(ctx, fontSize());
-        nvgFontFace(ctx, "sans");
+        nvgFontFaceId(ctx, mTheme->mFontNormal);
     }
 
     switch (mAlignment) {
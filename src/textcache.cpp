@@ -0,0 +1,284 @@
+/*
+    src/textcache.cpp -- Per-context cache of measured and line-broken text
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/textcache.h>
+#include <nanovg.h>
+#include <cstring>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+NAMESPACE_BEGIN(nanogui)
+
+/* Screens may be laid out in parallel, so the registry is locked. It is
+   only consulted when a thread switches contexts: each thread remembers the
+   last cache it used, and release() bumps the generation to forget those.
+   The caches themselves are only touched by the thread using their context */
+static std::mutex cacheRegistryMutex;
+static std::map<NVGcontext*, std::unique_ptr<TextLayoutCache>> cacheRegistry;
+static std::atomic<uint64_t> cacheGeneration { 0 };
+
+TextLayoutCache &TextLayoutCache::get(NVGcontext *ctx) {
+    thread_local NVGcontext *lastContext = nullptr;
+    thread_local TextLayoutCache *lastCache = nullptr;
+    thread_local uint64_t lastGeneration = 0;
+
+    uint64_t generation = cacheGeneration.load(std::memory_order_acquire);
+    if (ctx == lastContext && generation == lastGeneration)
+        return *lastCache;
+
+    std::lock_guard<std::mutex> guard(cacheRegistryMutex);
+    auto &cache = cacheRegistry[ctx];
+    if (!cache)
+        cache.reset(new TextLayoutCache(ctx));
+    lastContext = ctx;
+    lastCache = cache.get();
+    lastGeneration = generation;
+    return *cache;
+}
+
+void TextLayoutCache::release(NVGcontext *ctx) {
+    std::lock_guard<std::mutex> guard(cacheRegistryMutex);
+    cacheRegistry.erase(ctx);
+    cacheGeneration.fetch_add(1, std::memory_order_release);
+}
+
+static inline uint64_t hashCombine(uint64_t seed, uint64_t value) {
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+static inline uint64_t floatBits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+const TextRun &TextLayoutCache::measure(int font, float size, int align,
+                                        const std::string &text, float breakWidth,
+                                        float lineHeight) {
+    return lookup(font, size, align, text, breakWidth, lineHeight);
+}
+
+const TextRun &TextLayoutCache::measure(const char *font, float size, int align,
+                                        const std::string &text, float breakWidth,
+                                        float lineHeight) {
+    return lookup(FontRegistry::get(mContext).resolve(font), size, align, text,
+                  breakWidth, lineHeight);
+}
+
+TextRun &TextLayoutCache::lookup(int fontId, float size, int align,
+                                 const std::string &text, float breakWidth,
+                                 float lineHeight) {
+    NVGcontext *ctx = mContext;
+    nvgFontFaceId(ctx, fontId);
+    nvgFontSize(ctx, size);
+    nvgTextAlign(ctx, align);
+    nvgTextLineHeight(ctx, lineHeight);
+
+    if (breakWidth < 0.f)
+        breakWidth = 0.f;
+
+    uint64_t key = std::hash<std::string>()(text);
+    key = hashCombine(key, (uint64_t) (uint32_t) fontId);
+    key = hashCombine(key, floatBits(size));
+    key = hashCombine(key, (uint64_t) (uint32_t) align);
+    key = hashCombine(key, floatBits(breakWidth));
+    key = hashCombine(key, floatBits(lineHeight));
+
+    auto it = mIndex.find(key);
+    if (it != mIndex.end()) {
+        Entry &e = *it->second;
+        if (e.font == fontId && e.size == size && e.run.align == align &&
+            e.run.breakWidth == breakWidth && e.lineHeight == lineHeight &&
+            e.text == text) {
+            mRuns.splice(mRuns.begin(), mRuns, it->second);
+            return e.run;
+        }
+        /* Hash collision, the new run replaces the old one */
+        mRuns.erase(it->second);
+        mIndex.erase(it);
+    }
+
+    mRuns.emplace_front();
+    Entry &e = mRuns.front();
+    e.key = key;
+    e.font = fontId;
+    e.size = size;
+    e.lineHeight = lineHeight;
+    e.text = text;
+
+    TextRun &run = e.run;
+    run.align = align;
+    run.breakWidth = breakWidth;
+    const char *start = text.c_str(), *end = start + text.size();
+    if (breakWidth > 0.f) {
+        nvgTextBoxBounds(ctx, 0, 0, breakWidth, start, end, run.bounds);
+        nvgTextMetrics(ctx, nullptr, nullptr, &run.lineAdvance);
+        run.lineAdvance *= lineHeight;
+
+        NVGtextRow rows[8];
+        int nrows;
+        const char *pos = start;
+        while ((nrows = nvgTextBreakLines(ctx, pos, end, breakWidth, rows, 8)) > 0) {
+            for (int i = 0; i < nrows; ++i) {
+                run.rows.push_back({ (size_t) (rows[i].start - start),
+                                     (size_t) (rows[i].end - start),
+                                     rows[i].width });
+                run.advance = std::max(run.advance, rows[i].width);
+            }
+            pos = rows[nrows - 1].next;
+        }
+    } else {
+        run.advance = nvgTextBounds(ctx, 0, 0, start, end, run.bounds);
+    }
+
+    mIndex[key] = mRuns.begin();
+    while (mRuns.size() > mCapacity) {
+        mIndex.erase(mRuns.back().key);
+        mRuns.pop_back();
+    }
+    return run;
+}
+
+TextFit TextLayoutCache::fit(int font, float size, int align,
+                             const std::string &text, float maxWidth,
+                             Ellipsis mode, const char *ellipsis) {
+    TextFit result;
+    /* Measure the ellipsis first, the state is then left set for ``text`` */
+    float ellipsisWidth = lookup(font, size, align, ellipsis, 0.f, 1.f).advance;
+    TextRun &run = lookup(font, size, align, text, 0.f, 1.f);
+
+    result.headEnd = result.tailStart = text.size();
+    result.headWidth = result.width = run.advance;
+    if (run.advance <= maxWidth)
+        return result;
+
+    if (run.glyphX.empty() && !text.empty()) {
+        /* Pen positions are monotonic, which makes them prefix sums of the
+           glyph advances. A glyph never takes less than a byte. Centered or
+           right aligned text would shift them, so measure left aligned */
+        nvgTextAlign(mContext, NVG_ALIGN_LEFT | NVG_ALIGN_BASELINE);
+        std::vector<NVGglyphPosition> glyphs(text.size());
+        int count = nvgTextGlyphPositions(mContext, 0, 0, text.c_str(),
+                                          text.c_str() + text.size(),
+                                          glyphs.data(), (int) glyphs.size());
+        nvgTextAlign(mContext, align);
+        run.glyphOffsets.resize(count);
+        run.glyphX.resize(count);
+        for (int i = 0; i < count; ++i) {
+            run.glyphOffsets[i] = glyphs[i].str - text.c_str();
+            run.glyphX[i] = glyphs[i].x - glyphs[0].x;
+        }
+    }
+
+    const auto &xs = run.glyphX;
+    const auto &offsets = run.glyphOffsets;
+    size_t count = xs.size();
+    float available = std::max(maxWidth - ellipsisWidth, 0.f);
+
+    /* Number of leading glyphs whose pen advance fits into ``width`` */
+    auto headGlyphs = [&](float width) -> size_t {
+        if (run.advance <= width)
+            return count;
+        /* The first glyph starting beyond ``width`` is one past the answer */
+        auto it = std::upper_bound(xs.begin() + std::min<size_t>(1, count), xs.end(), width);
+        return (size_t) (it - xs.begin()) - (count > 0 ? 1 : 0);
+    };
+    /* Index of the first glyph of the longest suffix that fits into ``width`` */
+    auto tailGlyph = [&](float width) -> size_t {
+        auto it = std::lower_bound(xs.begin(), xs.end(), run.advance - width);
+        return it - xs.begin();
+    };
+    auto prefixWidth = [&](size_t glyphs) {
+        return glyphs < count ? xs[glyphs] : run.advance;
+    };
+    auto offsetOf = [&](size_t glyph) {
+        return glyph < count ? offsets[glyph] : text.size();
+    };
+
+    size_t head = 0, tail = count;
+    switch (mode) {
+        case Ellipsis::End:
+            head = headGlyphs(available);
+            break;
+        case Ellipsis::Start:
+            tail = tailGlyph(available);
+            break;
+        case Ellipsis::Middle:
+            head = headGlyphs(available * 0.5f);
+            tail = std::max(head, tailGlyph(available - prefixWidth(head)));
+            break;
+    }
+
+    result.truncated = true;
+    result.headEnd = offsetOf(head);
+    result.tailStart = offsetOf(tail);
+    result.headWidth = prefixWidth(head);
+    result.width = result.headWidth + ellipsisWidth + (run.advance - prefixWidth(tail));
+    return result;
+}
+
+std::string TextLayoutCache::elide(int font, float size, int align,
+                                   const std::string &text, float maxWidth,
+                                   Ellipsis mode, const char *ellipsis) {
+    TextFit f = fit(font, size, align, text, maxWidth, mode, ellipsis);
+    if (!f.truncated)
+        return text;
+    return text.substr(0, f.headEnd) + ellipsis + text.substr(f.tailStart);
+}
+
+void TextLayoutCache::drawBox(float x, float y, const TextRun &run,
+                              const std::string &text) const {
+    NVGcontext *ctx = mContext;
+    int halign = run.align & (NVG_ALIGN_LEFT | NVG_ALIGN_CENTER | NVG_ALIGN_RIGHT);
+    int valign = run.align & (NVG_ALIGN_TOP | NVG_ALIGN_MIDDLE | NVG_ALIGN_BOTTOM | NVG_ALIGN_BASELINE);
+
+    nvgTextAlign(ctx, NVG_ALIGN_LEFT | valign);
+    const char *str = text.c_str();
+    for (const auto &row : run.rows) {
+        float rx = x;
+        if (halign & NVG_ALIGN_CENTER)
+            rx += run.breakWidth * 0.5f - row.width * 0.5f;
+        else if (halign & NVG_ALIGN_RIGHT)
+            rx += run.breakWidth - row.width;
+        nvgText(ctx, rx, y, str + row.start, str + row.end);
+        y += run.lineAdvance;
+    }
+    nvgTextAlign(ctx, run.align);
+}
+
+void TextLayoutCache::setCapacity(size_t capacity) {
+    mCapacity = std::max<size_t>(capacity, 1);
+    while (mRuns.size() > mCapacity) {
+        mIndex.erase(mRuns.back().key);
+        mRuns.pop_back();
+    }
+}
+
+void TextLayoutCache::invalidateFont(int font) {
+    for (auto it = mRuns.begin(); it != mRuns.end(); ) {
+        if (it->font == font) {
+            mIndex.erase(it->key);
+            it = mRuns.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void TextLayoutCache::clear() {
+    mRuns.clear();
+    mIndex.clear();
+}
+
+NAMESPACE_END(nanogui)
@@ -0,0 +1,145 @@
+/*
+    src/textindex.cpp -- Trigram index for substring search in item lists
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/textindex.h>
+#include <algorithm>
+#include <iterator>
+
+NAMESPACE_BEGIN(nanogui)
+
+std::string TextIndex::fold(const std::string &str) {
+    std::string result(str);
+    for (auto &c : result)
+        if (c >= 'A' && c <= 'Z')
+            c = (char) (c - 'A' + 'a');
+    return result;
+}
+
+void TextIndex::build(const std::vector<std::string> &strings) {
+    mStrings.clear();
+    mStrings.reserve(strings.size());
+    mPostings.clear();
+    mHasLastResult = false;
+
+    for (const std::string &str : strings) {
+        mStrings.push_back(fold(str));
+        addPostings((uint32_t) mStrings.size() - 1);
+    }
+}
+
+void TextIndex::addPostings(uint32_t index) {
+    const std::string &str = mStrings[index];
+    bool last = index + 1 == (uint32_t) mStrings.size();
+    for (size_t j = 0; j + 3 <= str.size(); ++j) {
+        auto &list = mPostings[trigram(str.data() + j)];
+        /* Appended strings have the largest index, so lists stay sorted and
+           a repeated trigram only needs a look at the last entry */
+        if (last) {
+            if (list.empty() || list.back() != index)
+                list.push_back(index);
+        } else {
+            auto it = std::lower_bound(list.begin(), list.end(), index);
+            if (it == list.end() || *it != index)
+                list.insert(it, index);
+        }
+    }
+}
+
+void TextIndex::append(const std::string &str) {
+    mStrings.push_back(fold(str));
+    addPostings((uint32_t) mStrings.size() - 1);
+    mHasLastResult = false;
+}
+
+void TextIndex::update(uint32_t index, const std::string &str) {
+    if (index >= mStrings.size())
+        return;
+    std::string folded = fold(str);
+    if (folded == mStrings[index])
+        return;
+
+    const std::string &old = mStrings[index];
+    for (size_t j = 0; j + 3 <= old.size(); ++j) {
+        auto it = mPostings.find(trigram(old.data() + j));
+        if (it == mPostings.end())
+            continue;
+        auto &list = it->second;
+        auto pos = std::lower_bound(list.begin(), list.end(), index);
+        if (pos != list.end() && *pos == index)
+            list.erase(pos);
+    }
+    mStrings[index].swap(folded);
+    addPostings(index);
+    mHasLastResult = false;
+}
+
+const std::vector<uint32_t> &TextIndex::search(const std::string &query) {
+    std::string q = fold(query);
+    if (mHasLastResult && q == mLastQuery)
+        return mLastResult;
+
+    std::vector<uint32_t> result;
+    if (q.empty()) {
+        result.resize(mStrings.size());
+        for (uint32_t i = 0; i < (uint32_t) result.size(); ++i)
+            result[i] = i;
+    } else {
+        auto matches = [&](uint32_t i) { return mStrings[i].find(q) != std::string::npos; };
+
+        if (mHasLastResult && !mLastQuery.empty() && q.find(mLastQuery) != std::string::npos) {
+            /* Refinement of the previous query: matches can only shrink */
+            for (uint32_t i : mLastResult)
+                if (matches(i))
+                    result.push_back(i);
+        } else if (q.size() < 3) {
+            for (uint32_t i = 0; i < (uint32_t) mStrings.size(); ++i)
+                if (matches(i))
+                    result.push_back(i);
+        } else {
+            /* Intersect the posting lists, shortest first */
+            std::vector<const std::vector<uint32_t> *> lists;
+            bool missing = false;
+            for (size_t j = 0; j + 3 <= q.size() && !missing; ++j) {
+                auto it = mPostings.find(trigram(q.data() + j));
+                if (it == mPostings.end())
+                    missing = true;
+                else
+                    lists.push_back(&it->second);
+            }
+            if (!missing) {
+                std::sort(lists.begin(), lists.end(),
+                          [](const std::vector<uint32_t> *a, const std::vector<uint32_t> *b) {
+                              return a->size() < b->size();
+                          });
+                result = *lists[0];
+                std::vector<uint32_t> tmp;
+                for (size_t j = 1; j < lists.size() && !result.empty(); ++j) {
+                    tmp.clear();
+                    std::set_intersection(result.begin(), result.end(), lists[j]->begin(),
+                                          lists[j]->end(), std::back_inserter(tmp));
+                    result.swap(tmp);
+                }
+                /* Trigrams may occur in a different order, verify */
+                if (q.size() > 3)
+                    result.erase(std::remove_if(result.begin(), result.end(),
+                                                [&](uint32_t i) { return !matches(i); }),
+                                 result.end());
+            }
+        }
+    }
+
+    mLastQuery = q;
+    mLastResult.swap(result);
+    mHasLastResult = true;
+    return mLastResult;
+}
+
+NAMESPACE_END(nanogui)
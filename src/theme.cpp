@@ -14,153 +14,214 @@
 #include <nanogui/theme.h>
 #include <nanovg.h>
 #include <nanogui/entypo.h>
+#include <unordered_map>
+#include <stdexcept>
+#include <algorithm>
 
 NAMESPACE_BEGIN(nanogui)
 
 RTTI_IMPLEMENT_INFO(Theme, Object)
 
-#define CHECK(a) if (name == #a) return (a);
-#define CHECKSET(a) if (name == #a) { (a) = value; return; }
+/* Properties accessible by name. Font handles are left out, they are only
+   meaningful for the NanoVG context the theme was created with */
+#define NANOGUI_THEME_INT_PROPERTIES(X) \
+  X(mStandardFontSize) \
+  X(mButtonFontSize) \
+  X(mTextBoxFontSize) \
+  X(mWindowCornerRadius) \
+  X(mWindowHeaderHeight) \
+  X(mWindowDropShadowSize) \
+  X(mButtonCornerRadius) \
+  X(mTabInnerMargin) \
+  X(mTabMinButtonWidth) \
+  X(mTabMaxButtonWidth) \
+  X(mTabControlWidth) \
+  X(mTabButtonHorizontalPadding) \
+  X(mTabButtonVerticalPadding) \
+  X(mWindowFontSize) \
+  X(mWindowMenuHeaderOffset) \
+  X(mContextMenuShortcutOffset) \
+  X(mContextMenuMinWidth) \
+  X(mCheckBoxIcon) \
+  X(mContextSubmenu) \
+  X(mMessageInformationIcon) \
+  X(mMessageQuestionIcon) \
+  X(mMessageWarningIcon) \
+  X(mMessageAltButtonIcon) \
+  X(mMessagePrimaryButtonIcon) \
+  X(mPopupChevronRightIcon) \
+  X(mPopupChevronLeftIcon) \
+  X(mTabHeaderLeftIcon) \
+  X(mTabHeaderRightIcon) \
+  X(mTextBoxUpIcon) \
+  X(mTextBoxDownIcon) \
+  X(mWindowExpandedIcon) \
+  X(mWindowCollapsedIcon) \
+  X(mWindowMenuHeight) \
+  X(mTooltipOpacity)
+
+#define NANOGUI_THEME_FLOAT_PROPERTIES(X) \
+  X(mIconScale) \
+  X(mTabBorderWidth)
+
+#define NANOGUI_THEME_COLOR_PROPERTIES(X) \
+  X(mContextMenuShortcutTextColor) \
+  X(mSliderValueColor) \
+  X(mCheckboxUncheckedColor) \
+  X(mCheckboxCheckedColor) \
+  X(mCheckboxPushedColor) \
+  X(mSwitchboxBackgroundColor) \
+  X(mSwitchboxCheckedColor) \
+  X(mSwitchboxUncheckedColor) \
+  X(mScrollBarActiveColor) \
+  X(mScrollBarInactiveColor) \
+  X(mToleranceBarBorderColor) \
+  X(mToleranceBarBgColor) \
+  X(mToleranceBarLowColor) \
+  X(mToleranceBarHighColor) \
+  X(mDropShadow) \
+  X(mTransparent) \
+  X(mBorderDark) \
+  X(mBorderLight) \
+  X(mBorderMedium) \
+  X(mTextColor) \
+  X(mLabelTextDisabledColor) \
+  X(mDisabledTextColor) \
+  X(mTextColorShadow) \
+  X(mIconColor) \
+  X(mButtonGradientTopFocused) \
+  X(mButtonGradientBotFocused) \
+  X(mButtonGradientTopUnfocused) \
+  X(mButtonGradientBotUnfocused) \
+  X(mButtonGradientTopPushed) \
+  X(mButtonGradientBotPushed) \
+  X(mToggleButtonActiveColor) \
+  X(mToggleButtonInactiveColor) \
+  X(mWindowFillUnfocused) \
+  X(mWindowFillFocused) \
+  X(mWindowTitleUnfocused) \
+  X(mWindowTitleFocused) \
+  X(mWindowHeaderGradientTop) \
+  X(mWindowHeaderGradientBot) \
+  X(mWindowHeaderSepTop) \
+  X(mWindowHeaderSepBot) \
+  X(mWindowPopup) \
+  X(mWindowPopupTransparent) \
+  X(mTooltipBackgroundColor) \
+  X(mTooltipTextColor)
+
+namespace {
+  struct ThemeProperty {
+    enum Type { Int, Float, ColorValue } type;
+    int Theme::*i;
+    float Theme::*f;
+    Color Theme::*c;
+  };
+
+  using ThemePropertyTable = std::unordered_map<std::string, ThemeProperty>;
+
+  const ThemePropertyTable& themeProperties()
+  {
+    static const ThemePropertyTable table = [] {
+      ThemePropertyTable t;
+#define INT_PROPERTY(a) t[#a] = ThemeProperty{ ThemeProperty::Int, &Theme::a, nullptr, nullptr };
+#define FLOAT_PROPERTY(a) t[#a] = ThemeProperty{ ThemeProperty::Float, nullptr, &Theme::a, nullptr };
+#define COLOR_PROPERTY(a) t[#a] = ThemeProperty{ ThemeProperty::ColorValue, nullptr, nullptr, &Theme::a };
+      NANOGUI_THEME_INT_PROPERTIES(INT_PROPERTY)
+      NANOGUI_THEME_FLOAT_PROPERTIES(FLOAT_PROPERTY)
+      NANOGUI_THEME_COLOR_PROPERTIES(COLOR_PROPERTY)
+#undef INT_PROPERTY
+#undef FLOAT_PROPERTY
+#undef COLOR_PROPERTY
+      return t;
+    }();
+    return table;
+  }
+
+  const ThemeProperty& findProperty(const std::string& name)
+  {
+    auto it = themeProperties().find(name);
+    if (it == themeProperties().end())
+      throw std::runtime_error("Theme: unknown property \"" + name + "\"");
+    return it->second;
+  }
+
+  const ThemeProperty& findNumber(const std::string& name)
+  {
+    const ThemeProperty& prop = findProperty(name);
+    if (prop.type == ThemeProperty::ColorValue)
+      throw std::runtime_error("Theme: property \"" + name + "\" is a color, not a number");
+    return prop;
+  }
+
+  const ThemeProperty& findColor(const std::string& name)
+  {
+    const ThemeProperty& prop = findProperty(name);
+    if (prop.type != ThemeProperty::ColorValue)
+      throw std::runtime_error("Theme: property \"" + name + "\" is a number, not a color");
+    return prop;
+  }
+}
+
+bool Theme::hasProperty(const std::string& name)
+{
+  return themeProperties().count(name) != 0;
+}
+
 int Theme::get(const std::string& name, const int&)
 {
-  CHECK(mStandardFontSize)
-  CHECK(mButtonFontSize)
-  CHECK(mTextBoxFontSize)
-  CHECK(mIconScale)
-  CHECK(mWindowCornerRadius)
-  CHECK(mWindowHeaderHeight)
-  CHECK(mWindowDropShadowSize)
-  CHECK(mButtonCornerRadius)
-  CHECK(mTabBorderWidth)
-  CHECK(mTabInnerMargin)
-  CHECK(mTabMinButtonWidth)
-  CHECK(mTabMaxButtonWidth)
-  CHECK(mTabControlWidth)
-  CHECK(mTabButtonHorizontalPadding)
-  CHECK(mTabButtonVerticalPadding)
-  CHECK(mWindowMenuHeaderOffset)
-  CHECK(mWindowFontSize)
-  CHECK(mTooltipOpacity)
-  std::runtime_error(std::string("No get prop for name") + name);
-  return 0;
+  const ThemeProperty& prop = findNumber(name);
+  return prop.type == ThemeProperty::Int ? this->*prop.i : (int) (this->*prop.f);
 }
 
 void Theme::set(const std::string& name, const int& value)
 {
-  CHECKSET(mStandardFontSize)
-  CHECKSET(mButtonFontSize)
-  CHECKSET(mTextBoxFontSize)
-  CHECKSET(mIconScale)
-  CHECKSET(mWindowCornerRadius)
-  CHECKSET(mWindowHeaderHeight)
-  CHECKSET(mWindowDropShadowSize)
-  CHECKSET(mButtonCornerRadius)
-  CHECKSET(mTabBorderWidth)
-  CHECKSET(mTabInnerMargin)
-  CHECKSET(mTabMinButtonWidth)
-  CHECKSET(mTabMaxButtonWidth)
-  CHECKSET(mTabControlWidth)
-  CHECKSET(mTabButtonHorizontalPadding)
-  CHECKSET(mTabButtonVerticalPadding)
-  CHECKSET(mWindowMenuHeaderOffset)
-  CHECKSET(mWindowFontSize)
-  CHECKSET(mTooltipOpacity)
-  std::runtime_error(std::string("No set prop for name") + name);
+  const ThemeProperty& prop = findNumber(name);
+  if (prop.type == ThemeProperty::Int)
+    this->*prop.i = value;
+  else
+    this->*prop.f = (float) value;
+  ++mVersion;
+}
+
+float Theme::get(const std::string& name, const float&)
+{
+  const ThemeProperty& prop = findNumber(name);
+  return prop.type == ThemeProperty::Float ? this->*prop.f : (float) (this->*prop.i);
+}
+
+void Theme::set(const std::string& name, const float& value)
+{
+  const ThemeProperty& prop = findNumber(name);
+  if (prop.type == ThemeProperty::Float)
+    this->*prop.f = value;
+  else
+    this->*prop.i = (int) value;
+  ++mVersion;
 }
 
 Color Theme::get(const std::string& name, const Color&)
 {
-  CHECK(mDropShadow)
-  CHECK(mTransparent)
-  CHECK(mBorderDark)
-  CHECK(mBorderLight)
-  CHECK(mBorderMedium)
-  CHECK(mTextColor)
-  CHECK(mLabelTextDisabledColor)
-  CHECK(mDisabledTextColor)
-  CHECK(mTextColorShadow)
-  CHECK(mIconColor)
-  CHECK(mButtonGradientTopFocused)
-  CHECK(mButtonGradientBotFocused)
-  CHECK(mButtonGradientTopUnfocused)
-  CHECK(mButtonGradientBotUnfocused)
-  CHECK(mButtonGradientTopPushed)
-  CHECK(mButtonGradientBotPushed)
-  CHECK(mWindowFillUnfocused)
-  CHECK(mWindowFillFocused)
-  CHECK(mWindowTitleUnfocused)
-  CHECK(mWindowTitleFocused)
-  CHECK(mWindowHeaderGradientTop)
-  CHECK(mWindowHeaderGradientBot)
-  CHECK(mWindowHeaderSepTop)
-  CHECK(mWindowHeaderSepBot)
-  CHECK(mWindowPopup)
-  CHECK(mWindowPopupTransparent)
-  CHECK(mCheckboxUncheckedColor)
-  CHECK(mCheckboxCheckedColor)
-  CHECK(mCheckboxPushedColor)
-  CHECK(mSwitchboxBackgroundColor)
-  CHECK(mSwitchboxCheckedColor)
-  CHECK(mSwitchboxUncheckedColor)
-  CHECK(mScrollBarActiveColor)
-  CHECK(mScrollBarInactiveColor)
-  CHECK(mSliderValueColor)
-  CHECK(mContextMenuShortcutTextColor)
-  CHECK(mTooltipBackgroundColor)
-  CHECK(mTooltipTextColor)
-  CHECK(mToleranceBarBorderColor)
-  CHECK(mToleranceBarBgColor)
-  CHECK(mToleranceBarLowColor)
-  CHECK(mToleranceBarHighColor)
-  std::runtime_error(std::string("No get prop for name") + name);
-  return Color(0x800080ff);
+  return this->*findColor(name).c;
 }
 
 void Theme::set(const std::string& name, const Color& value)
 {
-  CHECKSET(mDropShadow)
-  CHECKSET(mTransparent)
-  CHECKSET(mBorderDark)
-  CHECKSET(mBorderLight)
-  CHECKSET(mBorderMedium)
-  CHECKSET(mTextColor)
-  CHECKSET(mLabelTextDisabledColor)
-  CHECKSET(mDisabledTextColor)
-  CHECKSET(mTextColorShadow)
-  CHECKSET(mIconColor)
-  CHECKSET(mButtonGradientTopFocused)
-  CHECKSET(mButtonGradientBotFocused)
-  CHECKSET(mButtonGradientTopUnfocused)
-  CHECKSET(mButtonGradientBotUnfocused)
-  CHECKSET(mButtonGradientTopPushed)
-  CHECKSET(mButtonGradientBotPushed)
-  CHECKSET(mWindowFillUnfocused)
-  CHECKSET(mWindowFillFocused)
-  CHECKSET(mWindowTitleUnfocused)
-  CHECKSET(mWindowTitleFocused)
-  CHECKSET(mWindowHeaderGradientTop)
-  CHECKSET(mWindowHeaderGradientBot)
-  CHECKSET(mWindowHeaderSepTop)
-  CHECKSET(mWindowHeaderSepBot)
-  CHECKSET(mWindowPopup)
-  CHECKSET(mWindowPopupTransparent)
-  CHECKSET(mCheckboxUncheckedColor)
-  CHECKSET(mCheckboxCheckedColor)
-  CHECKSET(mCheckboxPushedColor)
-  CHECKSET(mSwitchboxBackgroundColor)
-  CHECKSET(mSwitchboxCheckedColor)
-  CHECKSET(mSwitchboxUncheckedColor)
-  CHECKSET(mScrollBarActiveColor)
-  CHECKSET(mScrollBarInactiveColor)
-  CHECKSET(mSliderValueColor)
-  CHECKSET(mContextMenuShortcutTextColor)
-  CHECKSET(mTooltipBackgroundColor)
-  CHECKSET(mTooltipTextColor)
-  CHECKSET(mToleranceBarBorderColor)
-  CHECKSET(mToleranceBarBgColor)
-  CHECKSET(mToleranceBarLowColor)
-  CHECKSET(mToleranceBarHighColor)
-  std::runtime_error(std::string("No set prop for name") + name);
+  this->*findColor(name).c = value;
+  ++mVersion;
+}
+
+void Theme::apply(const Diff& diff)
+{
+  for (auto& v : diff.mInts) findNumber(v.first);
+  for (auto& v : diff.mFloats) findNumber(v.first);
+  for (auto& v : diff.mColors) findColor(v.first);
+
+  uint32_t version = mVersion;
+  for (auto& v : diff.mInts) set(v.first, v.second);
+  for (auto& v : diff.mFloats) set(v.first, v.second);
+  for (auto& v : diff.mColors) set(v.first, v.second);
+  mVersion = version + 1;
 }
 
 void fillThemeDefaultValues(Theme& theme)
@@ -286,8 +347,10 @@ void Theme::update(const Theme& newtheme)
   int oldFontNormal = mFontNormal;
   int oldFontBold = mFontBold;
   int oldFontIcons = mFontIcons;
+  uint32_t oldVersion = mVersion;
 
   memcpy(this, &newtheme, sizeof(Theme));
+  mVersion = std::max(oldVersion, newtheme.mVersion) + 1;
   if (mFontNormal == -1) mFontNormal = oldFontNormal;
   if (mFontBold == -1) mFontBold = oldFontBold;
   if (mFontIcons == -1) mFontIcons = oldFontIcons;
@@ -280,7 +280,7 @@ void ThemeBuilder::colorPicker(Widget& parent, std::string name)
   Color val = mDynTheme->get<Color>(name);
   auto cp_func = [this, name](const Color& color) {
     mDynTheme->set<Color>(name, color);
-    screen()->performLayout();
+    screen()->requestRedraw();
   };
 
   auto& cp = wrapper.wdg<ExplicitColorPicker>(val, cp_func);
@@ -324,7 +324,7 @@ void numberPicker(Widget& parent, Theme* dynamicTheme, std::string name)
 
   auto set_value = [&,dynamicTheme,name](ValueType v) {
     dynamicTheme->set<ValueType>(name, v);
-    parent.screen()->performLayout();
+    parent.screen()->requestRedraw();
   };
 
   box.setCallback(set_value);
@@ -0,0 +1,216 @@
+/*
+    src/tilesource.cpp -- Tiled, multi-resolution image data for ImageView
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/tilesource.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+NAMESPACE_BEGIN(nanogui)
+
+TileSource::TileSource(const Vector2i &size, int tileSize)
+    : mSize(size), mTileSize(tileSize), mLevelCount(1) {
+    if (size.x() <= 0 || size.y() <= 0 || tileSize <= 0)
+        throw std::runtime_error("TileSource: invalid image or tile size!");
+    int extent = std::max(size.x(), size.y());
+    while ((extent >> (mLevelCount - 1)) > tileSize)
+        mLevelCount++;
+}
+
+Vector2i TileSource::levelSize(int level) const {
+    return Vector2i(std::max((mSize.x() + (1 << level) - 1) >> level, 1),
+                    std::max((mSize.y() + (1 << level) - 1) >> level, 1));
+}
+
+Vector2i TileSource::tileCount(int level) const {
+    Vector2i size = levelSize(level);
+    return Vector2i((size.x() + mTileSize - 1) / mTileSize,
+                    (size.y() + mTileSize - 1) / mTileSize);
+}
+
+bool TileSource::readRegion(int, int, int, int, uint8_t *, size_t) {
+    return false;
+}
+
+void TileSource::setPyramidCacheSize(size_t bytes) {
+    std::lock_guard<std::mutex> guard(mPyramidMutex);
+    mPyramidCacheSize = bytes;
+    size_t tileBytes = (size_t) mTileSize * mTileSize * 4;
+    while (!mPyramid.empty() && mPyramid.size() * tileBytes > mPyramidCacheSize) {
+        mPyramidIndex.erase(mPyramid.back().key);
+        mPyramid.pop_back();
+    }
+}
+
+bool TileSource::cachedTile(uint64_t key, uint8_t *rgba, bool &valid) {
+    std::lock_guard<std::mutex> guard(mPyramidMutex);
+    auto it = mPyramidIndex.find(key);
+    if (it == mPyramidIndex.end())
+        return false;
+    mPyramid.splice(mPyramid.begin(), mPyramid, it->second);
+    valid = it->second->valid;
+    memcpy(rgba, it->second->rgba.data(), it->second->rgba.size());
+    return true;
+}
+
+void TileSource::cacheTile(uint64_t key, const uint8_t *rgba, bool valid) {
+    size_t tileBytes = (size_t) mTileSize * mTileSize * 4;
+    std::lock_guard<std::mutex> guard(mPyramidMutex);
+    if (tileBytes > mPyramidCacheSize || mPyramidIndex.count(key))
+        return; /* disabled, or built concurrently by another thread */
+
+    /* Reuse the buffer of the evicted tile */
+    std::vector<uint8_t> buffer;
+    while (!mPyramid.empty() && (mPyramid.size() + 1) * tileBytes > mPyramidCacheSize) {
+        mPyramidIndex.erase(mPyramid.back().key);
+        buffer.swap(mPyramid.back().rgba);
+        mPyramid.pop_back();
+    }
+    buffer.assign(rgba, rgba + tileBytes);
+    mPyramid.push_front(CachedTile { key, valid, std::move(buffer) });
+    mPyramidIndex[key] = mPyramid.begin();
+}
+
+bool TileSource::readTile(int level, int x, int y, uint8_t *rgba) {
+    const int t = mTileSize;
+
+    if (level == 0) {
+        memset(rgba, 0, (size_t) t * t * 4);
+        int width = std::min(t, mSize.x() - x * t);
+        int height = std::min(t, mSize.y() - y * t);
+        if (width <= 0 || height <= 0)
+            return false;
+        return readRegion(x * t, y * t, width, height, rgba, (size_t) t);
+    }
+
+    uint64_t key = ((uint64_t) level << 56) | ((uint64_t) (uint32_t) y << 28) | (uint32_t) x;
+    bool valid = false;
+    if (cachedTile(key, rgba, valid))
+        return valid;
+    memset(rgba, 0, (size_t) t * t * 4);
+
+    /* Box filter the (up to) four tiles of the finer level. Pixels outside
+       of the image are left out of the average so that edges don't fade */
+    Vector2i fineSize = levelSize(level - 1), fineCount = tileCount(level - 1);
+    std::vector<uint8_t> fine((size_t) t * t * 4);
+    bool any = false;
+    for (int j = 0; j < 2; ++j) {
+        for (int i = 0; i < 2; ++i) {
+            int fx = 2 * x + i, fy = 2 * y + j;
+            if (fx >= fineCount.x() || fy >= fineCount.y())
+                continue;
+            if (!readTile(level - 1, fx, fy, fine.data()))
+                continue;
+            any = true;
+            int validW = std::min(t, fineSize.x() - fx * t);
+            int validH = std::min(t, fineSize.y() - fy * t);
+            for (int py = 0; py < (validH + 1) / 2; ++py) {
+                uint8_t *out = rgba + ((size_t) (j * t / 2 + py) * t + i * t / 2) * 4;
+                for (int px = 0; px < (validW + 1) / 2; ++px, out += 4) {
+                    uint32_t sum[4] = { 0, 0, 0, 0 }, count = 0;
+                    for (int sy = 2 * py; sy < std::min(2 * py + 2, validH); ++sy) {
+                        for (int sx = 2 * px; sx < std::min(2 * px + 2, validW); ++sx) {
+                            const uint8_t *src = fine.data() + ((size_t) sy * t + sx) * 4;
+                            for (int c = 0; c < 4; ++c)
+                                sum[c] += src[c];
+                            count++;
+                        }
+                    }
+                    for (int c = 0; c < 4; ++c)
+                        out[c] = (uint8_t) (sum[c] / count);
+                }
+            }
+        }
+    }
+    cacheTile(key, rgba, any);
+    return any;
+}
+
+MappedFileTileSource::MappedFileTileSource(const std::string &path, const Vector2i &size,
+                                           size_t offset, int tileSize)
+    : TileSource(size, tileSize), mOffset(offset) {
+    size_t required = offset + (size_t) size.x() * size.y() * 4;
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("MappedFileTileSource: could not open \"" + path + "\"!");
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        throw std::runtime_error("MappedFileTileSource: could not query the size of \"" + path + "\"!");
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    mData = mapping ? (const uint8_t *) MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    mFile = file;
+    mMapping = mapping;
+    mMappedSize = (size_t) fileSize.QuadPart;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("MappedFileTileSource: could not open \"" + path + "\"!");
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw std::runtime_error("MappedFileTileSource: could not query the size of \"" + path + "\"!");
+    }
+    mMappedSize = (size_t) st.st_size;
+    void *data = mMappedSize > 0 ? mmap(nullptr, mMappedSize, PROT_READ, MAP_SHARED, fd, 0)
+                                 : MAP_FAILED;
+    close(fd);
+    mData = data != MAP_FAILED ? (const uint8_t *) data : nullptr;
+#endif
+    if (!mData || mMappedSize < required) {
+        unmap();
+        throw std::runtime_error("MappedFileTileSource: \"" + path + "\" is too small for the given size!");
+    }
+}
+
+MappedFileTileSource::~MappedFileTileSource() {
+    unmap();
+}
+
+void MappedFileTileSource::unmap() {
+#if defined(_WIN32)
+    if (mData)
+        UnmapViewOfFile(mData);
+    if (mMapping)
+        CloseHandle((HANDLE) mMapping);
+    if (mFile)
+        CloseHandle((HANDLE) mFile);
+    mMapping = mFile = nullptr;
+#else
+    if (mData)
+        munmap((void *) mData, mMappedSize);
+#endif
+    mData = nullptr;
+}
+
+bool MappedFileTileSource::readRegion(int x, int y, int width, int height,
+                                      uint8_t *rgba, size_t stride) {
+    size_t rowBytes = (size_t) mSize.x() * 4;
+    for (int row = 0; row < height; ++row)
+        memcpy(rgba + (size_t) row * stride * 4,
+               mData + mOffset + (size_t) (y + row) * rowBytes + (size_t) x * 4,
+               (size_t) width * 4);
+    return true;
+}
+
+NAMESPACE_END(nanogui)
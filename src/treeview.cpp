@@ -1,7 +1,9 @@
 #include <nanogui/treeview.h>
 #include <nanogui/scrollbar.h>
 #include <nanogui/treeviewitem.h>
+#include <nanogui/fontregistry.h>
 #include <nanovg.h>
+#include <algorithm>
 #include <string>
 
 #define DEFAULT_SCROLLBAR_SIZE 15
@@ -57,6 +59,7 @@ void TreeView::removeNode(TreeViewItem::NodeId id)
   auto* node = findNode(id);
   if (node)
     removeChild(node);
+  mFilterIndexValid = false;
 }
 
 TreeViewItem& TreeView::addNode()
@@ -64,6 +67,7 @@ TreeViewItem& TreeView::addNode()
   static TreeViewItem::NodeId nodeIdCounter = 1;
   auto& node = wdg<TreeViewItem>();
   *(const_cast<TreeViewItem::NodeId*>(&node.mNodeId)) = nodeIdCounter++;
+  mFilterIndexValid = false;
   return node;
 }
 
@@ -107,20 +111,17 @@ void TreeView::_recalculateItemsRectangle(NVGcontext* ctx)
     return;
 
   mNeedRecalculateItemsRectangle = false;
-  TreeViewItem*  node;
 
-  nvgFontFace(ctx, mFont.c_str());
+  nvgFontFaceId(ctx, FontRegistry::get(ctx).resolve(mFont));
   mItemHeight = nvgTextHeight(ctx, 0, 0, "A", nullptr, nullptr ) + 4;
 
   mIndentWidth = clamp<int>( mItemHeight, 9, 15) - 1;
 
   mTotalItemSize = Vector2i( 0, 0 );
-  node = mRoot->front();
-  while (node)
+  for (TreeViewItem* node : _shownNodes())
   {
     mTotalItemSize.y() += mItemHeight;
     mTotalItemSize.x() = std::max( mTotalItemSize.x(), node->right() - mRoot->left() );
-    node = node->nextVisible();
   }
 
   mScrollBarVscale = std::max(0, mTotalItemSize.y() - height() + mItemHeight);
@@ -207,8 +208,6 @@ void TreeView::_mouseAction( int xpos, int ypos, bool onlyHover /*= false*/ )
   TreeViewItem* selectedPtr = nullptr;
   TreeViewItem* hitNode;
   TreeViewItem::NodeId selIdx = TreeViewItem::BadNodeId;
-  int   n;
-  TreeViewItem*  node;
 
   xpos -= mPos.x();//_absoluteRect.UpperLeftCorner.X;
   ypos -= mPos.y();//_absoluteRect.UpperLeftCorner.Y;
@@ -219,20 +218,8 @@ void TreeView::_mouseAction( int xpos, int ypos, bool onlyHover /*= false*/ )
     selIdx = ( ( ypos - 1 ) + mScrollBarV->scroll() * mScrollBarVscale ) / mItemHeight;
   }
 
-  hitNode = nullptr;
-  node = mRoot->front();
-  n = 0;
-
-  while ( node )
-  {
-    if (selIdx == n)
-    {
-      hitNode = node;
-      break;
-    }
-    node = node->nextVisible();
-    ++n;
-  }
+  const std::vector<TreeViewItem*>& shown = _shownNodes();
+  hitNode = (selIdx >= 0 && selIdx < (int)shown.size()) ? shown[selIdx] : nullptr;
 
   if (onlyHover)
   {
@@ -259,7 +246,7 @@ void TreeView::_mouseAction( int xpos, int ypos, bool onlyHover /*= false*/ )
       bool expanded = hitNode->isExpanded();
     }
 
-    if (selectedPtr && !selectedPtr->isVisible())
+    if (selectedPtr && !isNodeShown(selectedPtr))
     {
       selectedPtr = nullptr;
       mSelected = TreeViewItem::BadNodeId;
@@ -287,7 +274,112 @@ std::string TreeView::_getCurrentNodeFont( TreeViewItem* node)
   return "sans";
 }
 
-void TreeView::recheckChildren() { mNeedRecheckChildren = true; }
+void TreeView::recheckChildren()
+{
+  mNeedRecheckChildren = true;
+  mFilterIndexValid = false;
+}
+
+void TreeView::setFilter(const std::string& query)
+{
+  if (query == mFilter)
+    return;
+
+  mFilter = query;
+  _applyFilter();
+}
+
+void TreeView::_applyFilter()
+{
+  mFilterShown.clear();
+  mShownNodes.clear();
+  mNeedRecalculateItemsRectangle = true;
+  updateItems();
+
+  if (mFilter.empty())
+    return;
+
+  if (!mFilterIndexValid)
+  {
+    std::vector<std::string> captions;
+    mFilterIds.clear();
+    mFilterNodes.clear();
+    for (auto& c : children())
+    {
+      auto twi = c->cast<TreeViewItem>();
+      if (!twi || twi == mRoot)
+        continue;
+
+      mFilterIds.push_back(twi->getNodeId());
+      mFilterNodes[twi->getNodeId()] = twi;
+      captions.push_back(twi->caption());
+    }
+    mFilterIndex.build(captions);
+    mFilterIndexValid = true;
+  }
+
+  // a match keeps the path to it, stop at the first ancestor already added
+  for (uint32_t i : mFilterIndex.search(mFilter))
+  {
+    TreeViewItem::NodeId id = mFilterIds[i];
+    while (id != TreeViewItem::RootNodeId && mFilterShown.insert(id).second)
+    {
+      auto it = mFilterNodes.find(id);
+      if (it == mFilterNodes.end())
+        break;
+      id = it->second->mParentId;
+    }
+  }
+
+  _collectShown(mRoot);
+}
+
+void TreeView::_collectShown(const TreeViewItem* node)
+{
+  // while filtering, nodes on the path to a match count as expanded
+  for (TreeViewItem::NodeId id : node->mChildrenIds)
+  {
+    if (!mFilterShown.count(id))
+      continue;
+
+    auto it = mFilterNodes.find(id);
+    if (it == mFilterNodes.end())
+      continue;
+
+    mShownNodes.push_back(it->second);
+    _collectShown(it->second);
+  }
+}
+
+bool TreeView::isNodeShown(const TreeViewItem* node) const
+{
+  if (!node)
+    return false;
+
+  if (node == mRoot)
+    return true;
+
+  if (mFilter.empty())
+    return node->isVisible();
+
+  return mFilterShown.count(node->getNodeId()) > 0;
+}
+
+const std::vector<TreeViewItem*>& TreeView::_shownNodes()
+{
+  if (!mFilter.empty())
+  {
+    // nodes were added, removed or renamed since the filter was applied
+    if (!mFilterIndexValid)
+      _applyFilter();
+    return mShownNodes;
+  }
+
+  mShownNodes.clear();
+  for (TreeViewItem* node = mRoot->front(); node; node = node->nextVisible())
+    mShownNodes.push_back(node);
+  return mShownNodes;
+}
 
 void TreeView::performLayout(NVGcontext *ctx)
 {
@@ -299,6 +391,10 @@ void TreeView::performLayout(NVGcontext *ctx)
 
 void TreeView::afterDraw(NVGcontext* ctx)
 {
+  // nodes were added, removed or renamed since the filter was applied
+  if (!mFilter.empty() && !mFilterIndexValid)
+    _applyFilter();
+
   if (mNeedRecheckChildren)
   {
     mNeedRecheckChildren = false;
@@ -350,9 +446,8 @@ void TreeView::afterDraw(NVGcontext* ctx)
     framePos.y() -= mScrollBarV->scroll() * mScrollBarVscale;
 
     Vector2i pos = framePos;
-    TreeViewItem* node = mRoot->front();
 
-    while ( node )
+    for (TreeViewItem* node : _shownNodes())
     {
       pos.x() = framePos.x() + (node->getLevel()-1) * mIndentWidth;
       pos.y() = framePos.y();
@@ -374,8 +469,6 @@ void TreeView::afterDraw(NVGcontext* ctx)
       node->setAnchorPosition(pos);
       node->setFixedSize({ width(), pfsize.y() });
 
-      node = node->nextVisible();
-
       framePos.y() += mItemHeight;
     }
   }
@@ -401,11 +494,10 @@ void TreeView::draw(NVGcontext* ctx)
     nvgStroke(ctx);
   }
 
-  TreeViewItem* node = mRoot->front();
   Vector2i rsize(mIndentWidth - 4, mIndentWidth - 4);
 
   Vector2i framePos;
-  while (node)
+  for (TreeViewItem* node : _shownNodes())
   {
     framePos = node->anchorPosition();
     Vector2i ns = node->size();
@@ -493,8 +585,6 @@ void TreeView::draw(NVGcontext* ctx)
       nvgStrokeColor(ctx, theme()->mBorderLight);
       nvgStroke(ctx);
     }
-
-    node = node->nextVisible();
   }
 
   // draw items
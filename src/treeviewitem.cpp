@@ -385,10 +385,10 @@ void TreeViewItem::performLayout(NVGcontext* ctx)
 
 void TreeViewItem::draw(NVGcontext *ctx)
 {
-  if ( !isVisible() )
+  if ( !source()->isNodeShown(this) )
     return;
 
-  nvgFontFace(ctx, mFont.c_str());
+  nvgFontFaceId(ctx, fontHandle(ctx));
   nvgFontSize(ctx, fontSize());
   Color color;
   if (enabled()) color = (mColor.w() > 0) ? mColor : mTheme->mTextColor;
@@ -0,0 +1,242 @@
+/*
+    src/virtuallist.cpp -- Scrollable list drawing only its visible rows
+
+    NanoGUI was developed by Wenzel Jakob <wenzel.jakob@epfl.ch>.
+    The widget drawing code is based on the NanoVG demo application
+    by Mikko Mononen.
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE.txt file.
+*/
+
+#include <nanogui/virtuallist.h>
+#include <nanogui/theme.h>
+#include <nanovg.h>
+#include <algorithm>
+
+NAMESPACE_BEGIN(nanogui)
+
+RTTI_IMPLEMENT_INFO(VirtualList, Widget)
+
+static const int scrollbarWidth = 12;
+
+VirtualList::VirtualList(Widget *parent) : Widget(parent) { }
+
+void VirtualList::setItems(int count, const ItemText &text) {
+    mItemCount = std::max(count, 0);
+    mItemText = text;
+    mRows.clear();
+    mFiltered = false;
+    mHoverRow = -1;
+    if (mSelectedIndex >= mItemCount)
+        mSelectedIndex = -1;
+    setScroll(0.f);
+}
+
+void VirtualList::setVisibleItems(const std::vector<uint32_t> &items) {
+    mRows = items;
+    mFiltered = true;
+    mHoverRow = -1;
+    setScroll(0.f);
+}
+
+void VirtualList::clearVisibleItems() {
+    mRows.clear();
+    mFiltered = false;
+    mHoverRow = -1;
+    setScroll(0.f);
+}
+
+int VirtualList::rowOfItem(int index) const {
+    if (index < 0 || index >= mItemCount)
+        return -1;
+    if (!mFiltered)
+        return index;
+    auto it = std::find(mRows.begin(), mRows.end(), (uint32_t) index);
+    return it != mRows.end() ? (int) (it - mRows.begin()) : -1;
+}
+
+void VirtualList::setSelectedIndex(int index) {
+    mSelectedIndex = (index >= 0 && index < mItemCount) ? index : -1;
+}
+
+void VirtualList::setScroll(float scroll) {
+    float maxScroll = (float) std::max(contentHeight() - mSize.y(), 0);
+    mScroll = std::min(std::max(scroll, 0.f), maxScroll);
+}
+
+void VirtualList::scrollToItem(int index) {
+    int row = rowOfItem(index);
+    if (row < 0)
+        return;
+    float top = (float) row * mRowHeight, bottom = top + mRowHeight;
+    if (top < mScroll)
+        setScroll(top);
+    else if (bottom > mScroll + mSize.y())
+        setScroll(bottom - mSize.y());
+}
+
+int VirtualList::rowAt(const Vector2i &p) const {
+    Vector2i local = p - mPos;
+    if (local.x() < 0 || local.y() < 0 || local.x() >= mSize.x() || local.y() >= mSize.y())
+        return -1;
+    int row = (int) ((local.y() + mScroll) / mRowHeight);
+    return row < rowCount() ? row : -1;
+}
+
+void VirtualList::activate(int row) {
+    if (row < 0 || row >= rowCount())
+        return;
+    mSelectedIndex = itemAtRow(row);
+    if (mCallback)
+        mCallback(mSelectedIndex);
+}
+
+Vector2i VirtualList::preferredSize(NVGcontext *ctx) const {
+    /* Only measure the rows the user will see first, not every item */
+    int width = 0;
+    if (mItemText) {
+        nvgFontSize(ctx, fontSize());
+        nvgFontFaceId(ctx, mTheme->mFontNormal);
+        int rows = std::min(rowCount(), mVisibleRowCount);
+        for (int row = 0; row < rows; ++row)
+            width = std::max(width, (int) nvgTextBounds(ctx, 0, 0, mItemText(itemAtRow(row)).c_str(),
+                                                        nullptr, nullptr));
+    }
+    return Vector2i(width + 16 + scrollbarWidth,
+                    std::max(std::min(rowCount(), mVisibleRowCount), 1) * mRowHeight);
+}
+
+void VirtualList::draw(NVGcontext *ctx) {
+    setScroll(mScroll);
+    int rows = rowCount();
+    bool scrollbar = contentHeight() > mSize.y();
+    int textWidth = mSize.x() - (scrollbar ? scrollbarWidth : 0);
+
+    nvgSave(ctx);
+    nvgIntersectScissor(ctx, mPos.x(), mPos.y(), mSize.x(), mSize.y());
+    nvgFontSize(ctx, fontSize());
+    nvgFontFaceId(ctx, mTheme->mFontNormal);
+    nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
+
+    /* Only the rows intersecting the widget are drawn */
+    int first = (int) (mScroll / mRowHeight);
+    int last = std::min(rows, (int) ((mScroll + mSize.y()) / mRowHeight) + 1);
+    for (int row = first; row < last; ++row) {
+        int index = itemAtRow(row);
+        float y = mPos.y() + row * mRowHeight - mScroll;
+        if (index == mSelectedIndex || row == mHoverRow) {
+            nvgBeginPath(ctx);
+            nvgRoundedRect(ctx, mPos.x() + 1, y + 1, textWidth - 2, mRowHeight - 2,
+                           mTheme->mButtonCornerRadius);
+            nvgFillColor(ctx, index == mSelectedIndex ? mTheme->mButtonGradientBotPushed
+                                                      : mTheme->mButtonGradientTopFocused);
+            nvgFill(ctx);
+        }
+        if (mItemText) {
+            nvgFillColor(ctx, mEnabled ? mTheme->mTextColor : mTheme->mDisabledTextColor);
+            nvgText(ctx, mPos.x() + 8, y + mRowHeight * 0.5f, mItemText(index).c_str(), nullptr);
+        }
+    }
+    nvgRestore(ctx);
+
+    if (!scrollbar)
+        return;
+
+    float scrollh = std::max(mSize.y() * mSize.y() / (float) contentHeight(), 12.f);
+    float maxScroll = (float) (contentHeight() - mSize.y());
+    float sliderY = mPos.y() + 4 + (mSize.y() - 8 - scrollh) * (mScroll / maxScroll);
+
+    NVGpaint paint = nvgBoxGradient(
+        ctx, mPos.x() + mSize.x() - scrollbarWidth + 1, mPos.y() + 4 + 1, 8,
+        mSize.y() - 8, 3, 4, Color(0, 32), Color(0, 92));
+    nvgBeginPath(ctx);
+    nvgRoundedRect(ctx, mPos.x() + mSize.x() - scrollbarWidth, mPos.y() + 4, 8,
+                   mSize.y() - 8, 3);
+    nvgFillPaint(ctx, paint);
+    nvgFill(ctx);
+
+    nvgBeginPath(ctx);
+    nvgRoundedRect(ctx, mPos.x() + mSize.x() - scrollbarWidth + 1, sliderY + 1, 6,
+                   scrollh - 2, 2);
+    nvgFillColor(ctx, mDraggingScrollbar ? mTheme->mScrollBarActiveColor
+                                         : mTheme->mScrollBarInactiveColor);
+    nvgFill(ctx);
+}
+
+bool VirtualList::mouseButtonEvent(const Vector2i &p, int button, bool down, int modifiers) {
+    if (!isMouseButtonLeft(button))
+        return Widget::mouseButtonEvent(p, button, down, modifiers);
+
+    bool scrollbar = contentHeight() > mSize.y();
+    if (down && scrollbar && p.x() >= mPos.x() + mSize.x() - scrollbarWidth) {
+        mDraggingScrollbar = true;
+        return true;
+    }
+    if (!down) {
+        if (!mDraggingScrollbar)
+            activate(rowAt(p));
+        mDraggingScrollbar = false;
+    }
+    if (down)
+        requestFocus();
+    return true;
+}
+
+bool VirtualList::mouseMotionEvent(const Vector2i &p, const Vector2i &, int, int) {
+    mHoverRow = rowAt(p);
+    return true;
+}
+
+bool VirtualList::mouseDragEvent(const Vector2i &, const Vector2i &rel, int, int) {
+    if (!mDraggingScrollbar)
+        return false;
+    float scrollh = std::max(mSize.y() * mSize.y() / (float) contentHeight(), 12.f);
+    float track = mSize.y() - 8 - scrollh;
+    if (track > 0)
+        setScroll(mScroll + rel.y() * (contentHeight() - mSize.y()) / track);
+    return true;
+}
+
+bool VirtualList::mouseEnterEvent(const Vector2i &p, bool enter) {
+    if (!enter)
+        mHoverRow = -1;
+    return Widget::mouseEnterEvent(p, enter);
+}
+
+bool VirtualList::scrollEvent(const Vector2i &p, const Vector2f &rel) {
+    if (contentHeight() <= mSize.y())
+        return Widget::scrollEvent(p, rel);
+    setScroll(mScroll - rel.y() * mRowHeight * 3);
+    mHoverRow = rowAt(p);
+    return true;
+}
+
+bool VirtualList::keyboardEvent(int key, int /* scancode */, int action, int /* modifiers */) {
+    if (!(isKeyboardActionPress(action) || isKeyboardActionRepeat(action)))
+        return false;
+    int rows = rowCount();
+    if (rows == 0)
+        return false;
+    int row = std::max(rowOfItem(mSelectedIndex), -1);
+
+    if (isKeyboardKey(key, "DOWN"))
+        row = std::min(row + 1, rows - 1);
+    else if (isKeyboardKey(key, "KBUP"))
+        row = std::max(row - 1, 0);
+    else if (isKeyboardKey(key, "HOME"))
+        row = 0;
+    else if (isKeyboardKey(key, "KEND"))
+        row = rows - 1;
+    else if (isKeyboardKey(key, "ENTR")) {
+        activate(std::max(row, 0));
+        return true;
+    } else
+        return false;
+
+    mSelectedIndex = itemAtRow(row);
+    scrollToItem(mSelectedIndex);
+    return true;
+}
+
+NAMESPACE_END(nanogui)
@@ -14,6 +14,10 @@
 
 #include <nanogui/screen.h>
 #include <nanogui/theme.h>
+#include <nanogui/textcache.h>
+#include <nanogui/imageloader.h>
+#include <nanogui/imagecache.h>
+#include <nanogui/fontregistry.h>
 #include <nanogui/window.h>
 #include <nanogui/popup.h>
 #include <map>
@@ -410,6 +414,10 @@ Screen::~Screen()
             glfwDestroyCursor((GLFWcursor*)mCursors[i]);
     }
 
+    AsyncImageLoader::release(mNVGContext);
+    ImageCache::release(mNVGContext);
+    TextLayoutCache::release(mNVGContext);
+    FontRegistry::release(mNVGContext);
     if (mNVGContext)
     {
         nvgDeleteVk(mNVGContext);
@@ -479,6 +487,7 @@ bool Screen::resizeCallbackEvent(int, int) {
         return false;
 
     mFBSize = fbSize; mSize = size;
+    mRedrawRequested = true;
     mLastInteraction = glfwGetTime();
 
     try {
@@ -307,6 +307,19 @@ int Widget::childIndex(Widget *widget) const {
 Window *Widget::window() { return findParent<Window>(); }
 Screen *Widget::screen() { return findParent<Screen>(); }
 
+Vector4i Widget::visibleRect() const {
+    Vector2i origin = absolutePosition() - mPos;
+    Vector4i r = absoluteRect();
+    for (const Widget *w = mParent; w; w = w->parent()) {
+        Vector4i a = w->absoluteRect();
+        r = Vector4i(std::max(r.x(), a.x()), std::max(r.y(), a.y()),
+                     std::min(r.z(), a.z()), std::min(r.w(), a.w()));
+    }
+    if (r.z() <= r.x() || r.w() <= r.y())
+        r = Vector4i(r.x(), r.y(), r.x(), r.y());
+    return r - origin;
+}
+
 void Widget::requestFocus() {
     Widget *widget = this;
     while (widget->parent())
@@ -314,6 +327,11 @@ void Widget::requestFocus() {
     ((Screen *) widget)->updateFocus(this);
 }
 
+void Widget::requestAnimationFrame(double delay) {
+    if (Screen *scr = screen())
+        scr->requestAnimationFrame(delay);
+}
+
 void Widget::draw(NVGcontext *ctx) {
     #if NANOGUI_SHOW_WIDGET_BOUNDS
         nvgStrokeWidth(ctx, 1.0f);
@@ -74,7 +74,7 @@ Vector2i Window::preferredSize(NVGcontext *ctx) const {
         mButtonPanel->setVisible(true);
 
     nvgFontSize(ctx, 18.0f);
-    nvgFontFace(ctx, "sans-bold");
+    nvgFontFaceId(ctx, mTheme->mFontBold);
     float bounds[4];
     nvgTextBounds(ctx, 0, 0, mTitle.c_str(), nullptr, bounds);
 
@@ -204,7 +204,7 @@ void Window::draw(NVGcontext *ctx) {
         nvgStroke(ctx);
 
         nvgFontSize(ctx, mFontSize ? mFontSize : theme()->mWindowFontSize);
-        nvgFontFace(ctx, "sans-bold");
+        nvgFontFaceId(ctx, mTheme->mFontBold);
         nvgTextAlign(ctx, NVG_ALIGN_CENTER | NVG_ALIGN_MIDDLE);
 
         nvgFontBlur(ctx, 2);
@@ -225,7 +225,7 @@ void Window::draw(NVGcontext *ctx) {
       mCollapseIconSize.y() = fontSize();
       mCollapseIconSize.y() *= mCollapseIconScale;
       nvgFontSize(ctx, mCollapseIconSize.y());
-      nvgFontFace(ctx, "icons");
+      nvgFontFaceId(ctx, mTheme->mFontIcons);
       mCollapseIconSize.x() = nvgTextBounds(ctx, 0, 0, icon.data(), nullptr, nullptr);
 
       nvgFillColor(ctx, mFocused ? mTheme->mWindowTitleFocused